@@ -0,0 +1,68 @@
+#!/usr/bin/env hhvm
+<?hh
+
+require_once dirname(dirname(dirname(__FILE__))).'/bootstrap.hh';
+
+use Zynga\Framework\Datadog\V2\Aggregation\Sketch;
+
+// --
+// Accuracy and size of the histogram sketch against the raw samples it
+// replaces, at a few relative accuracies. Samples are a long tailed latency
+// shape, mostly fast with the occasional slow outlier.
+//
+// usage: bin/benchmarks/datadog-sketch.hh [samples]
+// --
+
+$sampleCount = intval(idx($argv, 1, 100000));
+
+mt_srand(42);
+
+$samples = array();
+for ($i = 0; $i < $sampleCount; $i++) {
+  // exponential around 20ms with a 1% tail out to a few seconds.
+  $value = -20.0 * log(mt_rand(1, mt_getrandmax()) / mt_getrandmax());
+  if (mt_rand(1, 100) == 1) {
+    $value *= 50;
+  }
+  $samples[] = $value;
+}
+
+$sorted = $samples;
+sort($sorted);
+
+// What the wire would have carried, one 'latency:12.345|ms' line a sample.
+$rawBytes = 0;
+foreach ($samples as $value) {
+  $rawBytes += strlen('latency:'.round($value, 3).'|ms') + 1;
+}
+
+printf("samples=%d raw wire bytes=%d\n", $sampleCount, $rawBytes);
+
+$quantiles = array(0.5, 0.9, 0.95, 0.99, 0.999);
+
+foreach (array(0.05, 0.02, 0.01, 0.005) as $accuracy) {
+
+  $sketch = new Sketch($accuracy);
+
+  $start = microtime(true);
+  foreach ($samples as $value) {
+    $sketch->add($value);
+  }
+  $elapsed = microtime(true) - $start;
+
+  $worstError = 0.0;
+  foreach ($quantiles as $q) {
+    $exact = $sorted[(int) floor($q * ($sampleCount - 1))];
+    $error = abs($sketch->getQuantile($q) - $exact) / $exact;
+    $worstError = max($worstError, $error);
+  }
+
+  printf(
+    "accuracy=%-6s buckets=%5d worst quantile error=%6.3f%% add=%6.2f us/sample\n",
+    $accuracy,
+    $sketch->getBucketCount(),
+    $worstError * 100,
+    ($elapsed / $sampleCount) * 1000000,
+  );
+
+}
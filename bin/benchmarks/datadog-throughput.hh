@@ -0,0 +1,168 @@
+#!/usr/bin/env hhvm
+<?hh
+
+require_once dirname(dirname(dirname(__FILE__))).'/bootstrap.hh';
+
+use Zynga\Framework\Datadog\V2\Driver\UDP;
+use Zynga\Framework\Datadog\V2\Driver\UDS;
+use Zynga\Framework\Datadog\V2\Factory as DatadogFactory;
+use
+  Zynga\Framework\Datadog\V2\Interfaces\DriverInterface as DatadogDriverInterface
+;
+use Zynga\Framework\Datadog\V2\Testing\Listener;
+
+// --
+// Drives a factory built Datadog driver against an in process stand-in
+// listener and reports cpu per metric, packets/sec and loss for each send
+// mode. The listener drains every --drain metrics, a large value lets the
+// kernel buffer fill the way it does behind a slow agent.
+//
+// usage: bin/benchmarks/datadog-throughput.hh [udp|uds] [metrics] [rate]
+//          [drain]
+//   rate  metrics per second to pace at, 0 for as fast as possible
+// --
+
+$transport = strval(idx($argv, 1, 'udp'));
+$metricCount = intval(idx($argv, 2, 100000));
+$rate = intval(idx($argv, 3, 0));
+$drainEvery = max(1, intval(idx($argv, 4, 100)));
+
+DatadogFactory::disableMockDrivers();
+
+function cpuSeconds(): float {
+  $usage = getrusage();
+  return
+    $usage['ru_utime.tv_sec'] +
+    $usage['ru_utime.tv_usec'] / 1000000 +
+    $usage['ru_stime.tv_sec'] +
+    $usage['ru_stime.tv_usec'] / 1000000;
+}
+
+function createDriver(string $transport, Listener $listener): UDP {
+
+  DatadogFactory::clear();
+
+  if ($transport === 'uds') {
+    $dog = DatadogFactory::factory(DatadogDriverInterface::class, 'UDS');
+    if ($dog instanceof UDS) {
+      $dog->setSocketPath($listener->getAddress());
+      return $dog;
+    }
+  } else {
+    $dog = DatadogFactory::factory(DatadogDriverInterface::class, 'Poker');
+    if ($dog instanceof UDP) {
+      $dog->setServerAddress($listener->getAddress(), $listener->getPort());
+      return $dog;
+    }
+  }
+
+  echo "factory did not return a socket driver for $transport\n";
+  exit(1);
+
+}
+
+function runMode(
+  string $mode,
+  string $transport,
+  int $metricCount,
+  int $rate,
+  int $drainEvery,
+): void {
+
+  $listener = ($transport === 'uds') ?
+    Listener::uds(sys_get_temp_dir().'/zfw-dsd-bench-'.getmypid().'.sock') :
+    Listener::udp();
+
+  $dog = createDriver($transport, $listener);
+
+  if ($mode === 'aggregate') {
+    $dog->enableAggregation();
+  } else if ($mode === 'sketch') {
+    $dog->enableHistogramSketches();
+  } else if ($mode === 'deferred') {
+    $dog->enableDeferredFlush();
+  }
+
+  $tags = Map {'env' => 'bench', 'mode' => $mode};
+
+  $cpuStart = cpuSeconds();
+  $start = microtime(true);
+
+  for ($i = 0; $i < $metricCount; $i++) {
+
+    switch ($i % 4) {
+      case 0:
+        $dog->increment('bench.requests', 1.0, $tags);
+        break;
+      case 1:
+        $dog->timing('bench.latency', ($i % 250) / 1000.0, 1.0, $tags);
+        break;
+      case 2:
+        $dog->gauge('bench.queue_depth', floatval($i % 50), 1.0, $tags);
+        break;
+      default:
+        $dog->histogram('bench.payload', floatval($i % 4096), 1.0, $tags);
+    }
+
+    if ($i % $drainEvery == 0) {
+      $listener->receive();
+    }
+
+    if ($rate > 0) {
+      $due = $start + ($i + 1) / $rate;
+      $now = microtime(true);
+      if ($due > $now) {
+        usleep((int) (($due - $now) * 1000000));
+      }
+    }
+
+  }
+
+  // What the request pays, deferred sends happen after this point.
+  $cpuRequest = cpuSeconds() - $cpuStart;
+
+  if ($mode === 'deferred') {
+    $dog->flushDeferred();
+  } else {
+    $dog->flushAggregates();
+    $dog->flushPacket();
+  }
+
+  $elapsed = microtime(true) - $start;
+  $cpuTotal = cpuSeconds() - $cpuStart;
+
+  $listener->receive(0.1);
+
+  $sent = $dog->getPacketsSent();
+  $received = $listener->getPacketCount();
+  $lost = max(0, $sent - $received) + $dog->getPacketsDropped();
+  $attempted = $sent + $dog->getPacketsDropped();
+
+  printf(
+    "%-10s cpu=%6.2f us/metric (request %6.2f) packets=%7d %9.0f pkts/sec ".
+    "bytes=%9d loss=%5.2f%% dropped=%d\n",
+    $mode,
+    ($cpuTotal / $metricCount) * 1000000,
+    ($cpuRequest / $metricCount) * 1000000,
+    $sent,
+    $sent / $elapsed,
+    $dog->getBytesSent(),
+    ($attempted > 0) ? ($lost / $attempted) * 100 : 0.0,
+    $dog->getPacketsDropped(),
+  );
+
+  $listener->close();
+
+}
+
+printf(
+  "transport=%s metrics=%d rate=%s drain=%d\n",
+  $transport,
+  $metricCount,
+  ($rate > 0) ? $rate.'/s' : 'unthrottled',
+  $drainEvery,
+);
+
+foreach (array('plain', 'aggregate', 'sketch', 'deferred') as $mode) {
+  runMode($mode, $transport, $metricCount, $rate, $drainEvery);
+}
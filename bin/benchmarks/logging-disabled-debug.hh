@@ -0,0 +1,87 @@
+#!/usr/bin/env hhvm
+<?hh
+
+require_once dirname(dirname(dirname(__FILE__))).'/bootstrap.hh';
+
+use Zynga\Framework\Logging\V1\Level;
+use Zynga\Framework\Logging\V1\StaticLogger;
+
+// --
+// Cost of a debug log call that is turned off, the common case in
+// production. Compares the eager call, which builds its payload whether or
+// not it is logged, with the lazy closure call and an explicit level check.
+// NoLevelsSet has every level disabled.
+//
+// usage: bin/benchmarks/logging-disabled-debug.hh [calls]
+// --
+
+$calls = intval(idx($argv, 1, 1000000));
+$context = 'NoLevelsSet';
+
+function runCase(string $name, int $calls, (function(int): void) $body): void {
+
+  $start = microtime(true);
+
+  for ($i = 0; $i < $calls; $i++) {
+    $body($i);
+  }
+
+  $elapsed = microtime(true) - $start;
+
+  printf("%-28s %8.1f ns/call\n", $name, ($elapsed / $calls) * 1000000000);
+
+}
+
+function buildPayload(int $i): Map<string, mixed> {
+  return Map {
+    'iteration' => $i,
+    'key' => 'user:'.$i,
+    'state' => json_encode(array('a' => $i, 'b' => $i * 2)),
+  };
+}
+
+echo "calls=$calls context=$context\n";
+
+runCase(
+  'empty loop',
+  $calls,
+  (int $i) ==> {},
+);
+
+runCase(
+  'debug, empty payload',
+  $calls,
+  (int $i) ==> {
+    StaticLogger::debug('bench', Map {}, false, $context);
+  },
+);
+
+runCase(
+  'debug, eager payload',
+  $calls,
+  (int $i) ==> {
+    StaticLogger::debug('bench '.$i, buildPayload($i), false, $context);
+  },
+);
+
+runCase(
+  'debugLazy',
+  $calls,
+  (int $i) ==> {
+    StaticLogger::debugLazy(
+      () ==> tuple('bench '.$i, buildPayload($i)),
+      false,
+      $context,
+    );
+  },
+);
+
+runCase(
+  'isLevelEnabled guard',
+  $calls,
+  (int $i) ==> {
+    if (StaticLogger::isLevelEnabled(Level::DEBUG, $context)) {
+      StaticLogger::debug('bench '.$i, buildPayload($i), false, $context);
+    }
+  },
+);
@@ -0,0 +1,119 @@
+#!/usr/bin/env hhvm
+<?hh
+
+require_once dirname(dirname(dirname(__FILE__))).'/bootstrap.hh';
+
+use
+  Zynga\Framework\Database\V2\Driver\GenericPDO\ResultSet as V2ResultSet
+;
+use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
+use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\ResultSet;
+use
+  Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\Mock\RowsPDOStatement
+;
+
+// --
+// Compares the hasMore / next / fetchMap loop against the bulk fetch apis on
+// 100k rows, for the V2 GenericPDO result set and the V3 sharded one in both
+// buffering modes. The statement is an in memory stand-in so only the result
+// set overhead is measured, not the wire.
+//
+// The Vertica result sets wrap a live pgsql result resource, there is no in
+// memory stand-in for one so they are not covered here.
+//
+// usage: bin/benchmarks/result-set-fetch.hh [rows] [iterations]
+// --
+
+$rowCount = intval(idx($argv, 1, 100000));
+$iterations = intval(idx($argv, 2, 5));
+
+function createStatement(int $rowCount): RowsPDOStatement {
+  $sth = new RowsPDOStatement();
+  $sth->columnNames = Vector {'id', 'user_id', 'item_type_id', 'name'};
+  for ($i = 0; $i < $rowCount; $i++) {
+    $sth->rows->add(array($i, $i % 1000, $i % 50, 'item-name-'.$i));
+  }
+  return $sth;
+}
+
+function runCase(
+  string $name,
+  int $rowCount,
+  int $iterations,
+  (function(RowsPDOStatement): ResultSetInterface) $create,
+  (function(ResultSetInterface): int) $consume,
+): void {
+
+  $elapsed = 0.0;
+  $peak = 0;
+
+  for ($i = 0; $i < $iterations; $i++) {
+
+    $resultSet = $create(createStatement($rowCount));
+
+    $start = microtime(true);
+    $seen = $consume($resultSet);
+    $elapsed += microtime(true) - $start;
+
+    if ($seen != $rowCount) {
+      echo "$name: expected $rowCount rows, saw $seen\n";
+      exit(1);
+    }
+
+    $peak = max($peak, memory_get_peak_usage(true));
+
+  }
+
+  printf(
+    "%-36s %9.2f ms/iter %12.0f rows/sec peak=%dMB\n",
+    $name,
+    ($elapsed / $iterations) * 1000,
+    ($rowCount * $iterations) / $elapsed,
+    $peak / 1048576,
+  );
+
+}
+
+$rowLoop = (ResultSetInterface $rs) ==> {
+  $seen = 0;
+  while ($rs->hasMore() === true) {
+    $rs->next();
+    $row = $rs->fetchMap();
+    $seen++;
+  }
+  return $seen;
+};
+
+$columns = (ResultSetInterface $rs) ==> {
+  $data = $rs->fetchAllColumns();
+  return $data['id']->count();
+};
+
+$vectors = (ResultSetInterface $rs) ==> {
+  return $rs->fetchAllVectors()->count();
+};
+
+echo "rows=$rowCount iterations=$iterations\n";
+
+$cases = Map {
+  'v2 generic pdo' =>
+    (RowsPDOStatement $sth) ==> new V2ResultSet('SELECT bench', $sth),
+  'v3 unbuffered' =>
+    (RowsPDOStatement $sth) ==> new ResultSet(
+      'SELECT bench',
+      $sth,
+      ResultSet::BUFFERING_DISABLED,
+    ),
+  'v3 buffered' =>
+    (RowsPDOStatement $sth) ==> new ResultSet(
+      'SELECT bench',
+      $sth,
+      ResultSet::DEFAULT_MAX_BUFFERED_BYTES,
+    ),
+};
+
+foreach ($cases as $mode => $create) {
+  runCase($mode.' fetchMap loop', $rowCount, $iterations, $create, $rowLoop);
+  runCase($mode.' fetchAllColumns', $rowCount, $iterations, $create, $columns);
+  runCase($mode.' fetchAllVectors', $rowCount, $iterations, $create, $vectors);
+}
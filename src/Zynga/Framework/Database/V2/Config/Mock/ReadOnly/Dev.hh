@@ -0,0 +1,13 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Config\Mock\ReadOnly;
+
+use Zynga\Framework\Database\V2\Config\Mock\Dev as MockDev;
+
+class Dev extends MockDev {
+
+  public function isDatabaseReadOnly(): bool {
+    return true;
+  }
+
+}
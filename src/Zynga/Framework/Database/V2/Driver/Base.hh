@@ -2,10 +2,13 @@
 
 namespace Zynga\Framework\Database\V2\Driver;
 
+use Zynga\Framework\Database\V2\Driver\GenericPDO\Batch;
 use Zynga\Framework\Database\V2\Exceptions\MockQueriesRequired;
 use Zynga\Framework\Database\V2\Interfaces\DriverInterface;
 use Zynga\Framework\Database\V2\Interfaces\DriverConfigInterface;
+use Zynga\Framework\Database\V2\Interfaces\QueryObserverInterface;
 use Zynga\Framework\Database\V2\Interfaces\QuoteInterface;
+use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
 use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
 use
   Zynga\Framework\Environment\ErrorCapture\V1\Interfaces\ErrorCaptureInterface
@@ -13,6 +16,7 @@ use
 use
   Zynga\Framework\Environment\ErrorCapture\V1\Handler\Noop as ErrorCaptureNoop
 ;
+use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\Factory\V2\Driver\Base as FactoryDriverBase;
 
 abstract class Base extends FactoryDriverBase implements DriverInterface {
@@ -24,6 +28,7 @@ abstract class Base extends FactoryDriverBase implements DriverInterface {
   private ErrorCaptureInterface $_errorCapture;
   private bool $_hadError;
   private string $_lastError;
+  private Vector<QueryObserverInterface> $_queryObservers;
 
   public function __construct(DriverConfigInterface $config) {
     $this->_config = $config;
@@ -31,6 +36,7 @@ abstract class Base extends FactoryDriverBase implements DriverInterface {
     $this->_requireMockQueries = false;
     $this->_hadError = false;
     $this->_lastError = '';
+    $this->_queryObservers = Vector {};
   }
 
   public function getConfig(): DriverConfigInterface {
@@ -74,6 +80,54 @@ abstract class Base extends FactoryDriverBase implements DriverInterface {
     return false;
   }
 
+  /**
+   * Fallback for drivers without a multi statement path, one round trip per
+   * statement.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<ResultSetInterface> {
+
+    $results = Vector {};
+
+    if ($atomic === true) {
+      $this->transaction()->begin();
+    }
+
+    try {
+
+      foreach ($statements as $sql) {
+        $results->add($this->query($sql));
+      }
+
+      if ($atomic === true) {
+        $this->transaction()->commit();
+      }
+
+      return $results;
+
+    } catch (Exception $e) {
+      if ($atomic === true) {
+        $this->transaction()->rollback();
+      }
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Normalizes the statements of a batch (no trailing ;), optionally
+   * bracketed by $begin / $commit.
+   */
+  protected function prepareBatch(
+    Vector<string> $statements,
+    string $begin = '',
+    string $commit = '',
+  ): Vector<string> {
+    return Batch::prepare($statements, $begin, $commit);
+  }
+
   public function errorCapture(): ErrorCaptureInterface {
     return $this->_errorCapture;
   }
@@ -92,4 +146,38 @@ abstract class Base extends FactoryDriverBase implements DriverInterface {
     return $this->_lastError;
   }
 
+  public function addQueryObserver(QueryObserverInterface $observer): bool {
+    $this->_queryObservers->add($observer);
+    return true;
+  }
+
+  public function getQueryObservers(): Vector<QueryObserverInterface> {
+    return $this->_queryObservers->toVector();
+  }
+
+  public function clearQueryObservers(): bool {
+    $this->_queryObservers->clear();
+    return true;
+  }
+
+  public function hasQueryObservers(): bool {
+    return $this->_queryObservers->count() > 0;
+  }
+
+  /**
+   * Hands a finished query to every observer, $startTime is the
+   * microtime(true) taken before the query was sent.
+   */
+  protected function notifyQueryObservers(
+    string $sql,
+    float $startTime,
+    int $numRows,
+    bool $wasSuccessful,
+  ): void {
+    $elapsed = microtime(true) - $startTime;
+    foreach ($this->_queryObservers as $observer) {
+      $observer->observe($sql, $elapsed, $numRows, $wasSuccessful);
+    }
+  }
+
 }
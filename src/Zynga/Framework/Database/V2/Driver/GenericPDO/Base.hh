@@ -5,6 +5,7 @@ namespace Zynga\Framework\Database\V2\Driver\GenericPDO;
 use \PDO;
 use \PDOException;
 use Zynga\Framework\Database\V2\Driver\Base as BaseDriver;
+use Zynga\Framework\Database\V2\Driver\GenericPDO\Batch;
 use Zynga\Framework\Database\V2\Driver\GenericPDO\ConnectionContainer;
 use Zynga\Framework\Database\V2\Driver\GenericPDO\Quoter;
 use Zynga\Framework\Database\V2\Driver\GenericPDO\ResultSet;
@@ -29,7 +30,7 @@ class Base extends BaseDriver {
 
   private ?PDO $_dbh;
   private ?QuoteInterface $_quoter;
-  private ?TransactionInterface $_transaction;
+  private ?Transaction $_transaction;
   private bool $_connectionState;
 
   /**
@@ -61,11 +62,13 @@ class Base extends BaseDriver {
    * See @BaseDriver
    */
   public function getTransaction(): TransactionInterface {
-    if ($this->_transaction === null) {
-      $this->_transaction = new Transaction($this);
+    $transaction = $this->_transaction;
+    if ($transaction === null) {
+      $transaction = new Transaction($this);
+      $this->_transaction = $transaction;
     }
 
-    return $this->_transaction;
+    return $transaction;
   }
 
   /**
@@ -142,6 +145,8 @@ class Base extends BaseDriver {
    */
   public function query(string $sql): ResultSetInterface {
 
+    $startTime = microtime(true);
+
     try {
 
       if ($this->getConfig()->isDatabaseReadOnly() === true &&
@@ -165,16 +170,104 @@ class Base extends BaseDriver {
       $options[PDO::ATTR_CURSOR] = PDO::CURSOR_SCROLL;
       $query = $driver->prepare($sql, $options);
       $query->execute();
+
+      if ($this->hasQueryObservers() === true) {
+        $this->notifyQueryObservers($sql, $startTime, $query->rowCount(), true);
+      }
+
       return new ResultSet($sql, $query);
 
     } catch (PDOException $e) {
       $this->recordError($e->getMessage());
+      $this->notifyQueryObservers($sql, $startTime, 0, false);
       throw new QueryFailedException($e->getMessage());
     } catch (Exception $e) {
       throw $e;
     }
   }
 
+  /**
+   * Sends every statement as one multi statement query and walks the
+   * rowsets, so a batch costs a single round trip. When atomic the batch is
+   * bracketed with START TRANSACTION / COMMIT in the same trip, and a failure
+   * part way issues a ROLLBACK. Inside an already open transaction the
+   * bracket is left off, the batch joins it and the caller commits or rolls
+   * back.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<ResultSetInterface> {
+
+    if ($statements->count() == 0) {
+      return Vector {};
+    }
+
+    $startTime = microtime(true);
+
+    $batch = null;
+
+    try {
+
+      foreach ($statements as $statement) {
+        if ($this->getConfig()->isDatabaseReadOnly() === true &&
+            $this->isSqlDML(trim($statement)) === true) {
+          throw new ConnectionIsReadOnly('sql='.$statement);
+        }
+      }
+
+      if ($this->getIsConnected() !== true) {
+        $this->connect();
+      }
+
+      if ($this->_dbh === null) {
+        throw new ConnectionGoneAwayException(
+          'NO_CONNECTION host='.$this->getConfig()->getConnectionString(),
+        );
+      }
+
+      $dbh = $this->_dbh;
+
+      $batch = new Batch(
+        $statements,
+        $atomic === true && $this->isInTransaction($dbh) !== true,
+      );
+
+      $results = $batch->execute($dbh);
+
+      $this->notifyQueryObservers(
+        $batch->getSql(),
+        $startTime,
+        $batch->getNumRows(),
+        true,
+      );
+
+      return $results;
+
+    } catch (QueryFailedException $e) {
+
+      $this->recordError($e->getMessage());
+
+      if ($batch !== null) {
+        $this->notifyQueryObservers($batch->getSql(), $startTime, 0, false);
+      }
+
+      throw $e;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  private function isInTransaction(PDO $dbh): bool {
+    $transaction = $this->_transaction;
+    if ($transaction !== null && $transaction->isOpen() === true) {
+      return true;
+    }
+    return $dbh->inTransaction();
+  }
+
   /**
    * See @BaseDriver
    */
@@ -163,4 +163,100 @@ class BaseTest extends TestCase {
     $this->assertEquals("'a-value'", $driver->nativeQuoteString('a-value'));
   }
 
+  public function testQueryBatch(): void {
+
+    $config = new MockConfig();
+    $driver = new Base($config);
+
+    $stamp = time() + mt_rand(1, 100000);
+
+    $results = $driver->queryBatch(
+      Vector {
+        'INSERT INTO phpunit (unit_test_stamp, int_data) VALUES ('.$stamp.', 1)',
+        'INSERT INTO phpunit (unit_test_stamp, int_data) VALUES ('.$stamp.', 2);',
+        'UPDATE phpunit SET int_data = 3 WHERE unit_test_stamp = '.$stamp,
+        'SELECT int_data FROM phpunit WHERE unit_test_stamp = '.$stamp,
+      },
+      true,
+    );
+
+    $this->assertEquals(4, $results->count());
+    $this->assertEquals(1, $results[0]->getNumRows());
+    $this->assertEquals(2, $results[2]->getNumRows());
+    $this->assertTrue($results[2]->wasSqlDML());
+
+    $select = $results[3];
+    $this->assertEquals(2, $select->getNumRows());
+    $this->assertTrue($select->next());
+    $this->assertEquals(3, intval($select->fetchMap()['int_data']));
+
+    $driver->query('DELETE FROM phpunit WHERE unit_test_stamp = '.$stamp);
+
+  }
+
+  public function testQueryBatch_Empty(): void {
+    $driver = new Base(new MockConfig());
+    $this->assertEquals(0, $driver->queryBatch(Vector {})->count());
+  }
+
+  public function testQueryBatch_RollsBack(): void {
+
+    $config = new MockConfig();
+    $driver = new Base($config);
+
+    $stamp = time() + mt_rand(1, 100000);
+
+    try {
+      $driver->queryBatch(
+        Vector {
+          'INSERT INTO phpunit (unit_test_stamp, int_data) VALUES ('.$stamp.', 1)',
+          'SELECT 1 "bad-query, needs comma and a quote',
+        },
+        true,
+      );
+      $this->fail('broken statement should fail the batch');
+    } catch (QueryFailedException $e) {
+      $this->assertContains('batch statement=1', $e->getMessage());
+    }
+
+    $rs = $driver->query(
+      'SELECT COUNT(*) AS cnt FROM phpunit WHERE unit_test_stamp = '.$stamp,
+    );
+    $rs->next();
+    $this->assertEquals(0, intval($rs->fetchMap()['cnt']));
+
+  }
+
+  public function testQueryBatch_InsideOpenTransaction(): void {
+
+    $driver = new Base(new MockConfig());
+
+    $stamp = time() + mt_rand(1, 100000);
+
+    $driver->getTransaction()->begin();
+
+    // Atomic inside the caller's transaction joins it instead of committing.
+    $driver->queryBatch(
+      Vector {
+        'INSERT INTO phpunit (unit_test_stamp, int_data) VALUES ('.$stamp.', 1)',
+      },
+      true,
+    );
+
+    $driver->getTransaction()->rollback();
+
+    $rs = $driver->query(
+      'SELECT COUNT(*) AS cnt FROM phpunit WHERE unit_test_stamp = '.$stamp,
+    );
+    $rs->next();
+    $this->assertEquals(0, intval($rs->fetchMap()['cnt']));
+
+  }
+
+  public function testQueryBatch_ReadOnlyButHasDML(): void {
+    $driver = new Base(new MockReadOnlyConfig());
+    $this->expectException(ConnectionIsReadOnly::class);
+    $driver->queryBatch(Vector {'SELECT 1', 'DELETE FROM phpunit'});
+  }
+
 }
@@ -0,0 +1,136 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Driver\GenericPDO;
+
+use \PDO;
+use \PDOException;
+use Zynga\Framework\Database\V2\Driver\ResultSet\Buffered;
+use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
+use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
+
+/**
+ * One multi statement query over a PDO connection, shared by the plain and
+ * the sharded GenericPDO drivers. The rowsets are walked into a buffered
+ * result per statement. When bracketed the batch is wrapped in
+ * START TRANSACTION / COMMIT in the same round trip and a failure part way
+ * issues a ROLLBACK, the bracket results are not handed back.
+ */
+class Batch {
+  const string BEGIN = 'START TRANSACTION';
+  const string COMMIT = 'COMMIT';
+
+  private Vector<string> $_batch;
+  private bool $_isBracketed;
+  private int $_numRows;
+
+  public function __construct(Vector<string> $statements, bool $isBracketed) {
+    $this->_isBracketed = $isBracketed;
+    $this->_batch = $isBracketed === true
+      ? self::prepare($statements, self::BEGIN, self::COMMIT)
+      : self::prepare($statements);
+    $this->_numRows = 0;
+  }
+
+  /**
+   * Normalizes the statements of a batch (no trailing ;), optionally
+   * bracketed by $begin / $commit.
+   */
+  public static function prepare(
+    Vector<string> $statements,
+    string $begin = '',
+    string $commit = '',
+  ): Vector<string> {
+
+    $batch = Vector {};
+
+    if ($begin !== '') {
+      $batch->add($begin);
+    }
+
+    foreach ($statements as $sql) {
+      $batch->add(rtrim(trim($sql), ';'));
+    }
+
+    if ($commit !== '') {
+      $batch->add($commit);
+    }
+
+    return $batch;
+
+  }
+
+  public function getSql(): string {
+    return implode(";\n", $this->_batch);
+  }
+
+  /**
+   * Rows returned or affected across the whole batch.
+   */
+  public function getNumRows(): int {
+    return $this->_numRows;
+  }
+
+  /**
+   * Failures come back as a QueryFailedException naming the offset of the
+   * caller's statement that failed, the bracket does not count.
+   */
+  public function execute(PDO $dbh): Vector<ResultSetInterface> {
+
+    $results = Vector {};
+
+    $offset = 0;
+
+    try {
+
+      $query = $dbh->query($this->getSql());
+
+      do {
+
+        $rows = Vector {};
+
+        if ($query->columnCount() > 0) {
+          $fetched = $query->fetchAll(PDO::FETCH_ASSOC);
+          if (is_array($fetched)) {
+            foreach ($fetched as $row) {
+              $rows->add($row);
+            }
+          }
+        }
+
+        $rowCount = $query->rowCount();
+        $this->_numRows += $rowCount;
+
+        $results->add(new Buffered($this->_batch[$offset], $rows, $rowCount));
+
+        $offset++;
+
+      } while ($query->nextRowset());
+
+    } catch (PDOException $e) {
+
+      if ($this->_isBracketed === true) {
+        try {
+          $dbh->exec('ROLLBACK');
+        } catch (PDOException $rollbackException) {
+          // The original failure is the one worth reporting.
+        }
+        $offset = max(0, $offset - 1);
+      }
+
+      throw new QueryFailedException(
+        'batch statement='.$offset.' error='.$e->getMessage(),
+      );
+
+    }
+
+    if ($this->_isBracketed === true) {
+      // Drop the START TRANSACTION / COMMIT results.
+      $results->removeKey(0);
+      $results->pop();
+    }
+
+    return $results;
+
+  }
+
+}
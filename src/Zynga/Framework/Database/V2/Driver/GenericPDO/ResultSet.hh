@@ -177,6 +177,75 @@ class ResultSet extends Base {
     return $data;
   }
 
+  /**
+   * See @Base
+   * A fresh result set is pulled with a single native fetchAll.
+   */
+  public function fetchAllColumns(): Map<string, Vector<mixed>> {
+    if ($this->pdoStatement === null) {
+      throw new NoActiveCursorException(
+        'fetchAllColumns requires an active resultset sql='.$this->sql,
+      );
+    }
+
+    if ($this->currentPosition != -1) {
+      return parent::fetchAllColumns();
+    }
+
+    $pdoStatement = $this->pdoStatement;
+
+    $columnNames = Vector {};
+    for ($offset = 0; $offset < $pdoStatement->columnCount(); $offset++) {
+      $meta = $pdoStatement->getColumnMeta($offset);
+      $columnNames->add(strval($meta['name']));
+    }
+
+    $rows = $this->fetchAllNative(PDO::FETCH_NUM);
+
+    return $this->pivotToColumns($columnNames, $rows);
+  }
+
+  /**
+   * See @Base
+   */
+  public function fetchAllVectors(): Vector<Vector<mixed>> {
+    if ($this->pdoStatement === null) {
+      throw new NoActiveCursorException(
+        'fetchAllVectors requires an active resultset sql='.$this->sql,
+      );
+    }
+
+    if ($this->currentPosition != -1) {
+      return parent::fetchAllVectors();
+    }
+
+    $data = Vector {};
+    foreach ($this->fetchAllNative(PDO::FETCH_NUM) as $row) {
+      $data->add(new Vector($row));
+    }
+
+    return $data;
+  }
+
+  private function fetchAllNative(int $fetchStyle): array<array<mixed>> {
+    $pdoStatement = $this->pdoStatement;
+
+    if ($pdoStatement === null || $pdoStatement->columnCount() == 0) {
+      return array();
+    }
+
+    $rawData = $pdoStatement->fetchAll($fetchStyle);
+
+    // everything has been read, park the cursor at the end.
+    $this->currentPosition = $this->getNumRows() - 1;
+
+    if (is_array($rawData)) {
+      return $rawData;
+    }
+
+    return array();
+  }
+
   /**
    * See @Base
    */
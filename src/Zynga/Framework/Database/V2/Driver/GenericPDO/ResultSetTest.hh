@@ -106,6 +106,29 @@ class ResultSetTest extends TestCase {
     $this->assertEquals(1, count($resultSet->fetchVector()));
   }
 
+  public function testFetchAllColumnsNoActiveCursorException(): void {
+    $resultSet = new ResultSet('', null);
+    $this->expectException(NoActiveCursorException::class);
+    $resultSet->fetchAllColumns();
+  }
+
+  public function testFetchAllColumnsEmpty(): void {
+    $resultSet = new ResultSet('', new PDOStatement());
+    $this->assertEquals(0, $resultSet->fetchAllColumns()->count());
+    $this->assertFalse($resultSet->hasMore());
+  }
+
+  public function testFetchAllVectorsNoActiveCursorException(): void {
+    $resultSet = new ResultSet('', null);
+    $this->expectException(NoActiveCursorException::class);
+    $resultSet->fetchAllVectors();
+  }
+
+  public function testFetchAllVectorsEmpty(): void {
+    $resultSet = new ResultSet('', new PDOStatement());
+    $this->assertEquals(0, $resultSet->fetchAllVectors()->count());
+  }
+
   public function testSetSqlSuccess(): void {
     $resultSet = new ResultSet('', new PDOStatement());
     $this->assertTrue($resultSet->setSql(''));
@@ -10,6 +10,7 @@ use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
  */
 class Transaction implements TransactionInterface {
   private DriverInterface $driver;
+  private bool $isOpen = false;
 
   /**
    * Initializes this instance of Transaction
@@ -25,6 +26,7 @@ class Transaction implements TransactionInterface {
    */
   public function begin(): bool {
     $this->execute('START TRANSACTION');
+    $this->isOpen = true;
     return true;
   }
 
@@ -32,6 +34,7 @@ class Transaction implements TransactionInterface {
    * See @TransactionInterface
    */
   public function commit(): bool {
+    $this->isOpen = false;
     $this->execute('COMMIT');
     return true;
   }
@@ -40,10 +43,18 @@ class Transaction implements TransactionInterface {
    * See @TransactionInterface
    */
   public function rollback(): bool {
+    $this->isOpen = false;
     $this->execute('ROLLBACK');
     return true;
   }
 
+  /**
+   * True between a begin() and its commit() / rollback().
+   */
+  public function isOpen(): bool {
+    return $this->isOpen;
+  }
+
   /**
    * Executes a sql query
    *
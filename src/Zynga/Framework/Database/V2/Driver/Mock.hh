@@ -84,6 +84,8 @@ class Mock extends Base {
 
   public function query(string $sql): ResultSetInterface {
 
+    $startTime = microtime(true);
+
     try {
 
       $this->_queryCounter++;
@@ -96,6 +98,7 @@ class Mock extends Base {
       );
 
       if ($rsData->get(0) === false) {
+        $this->notifyQueryObservers($sql, $startTime, 0, false);
         throw new QueryFailedException('The query failed! sql='.$sql);
       }
 
@@ -106,6 +109,10 @@ class Mock extends Base {
 
       $this->_resultOffset++;
 
+      if ($this->hasQueryObservers() === true) {
+        $this->notifyQueryObservers($sql, $startTime, $rs->getNumRows(), true);
+      }
+
       return $rs;
 
     } catch (Exception $e) {
@@ -4,6 +4,7 @@ namespace Zynga\Framework\Database\V2\Driver;
 
 use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
 use Zynga\Framework\Database\V2\Factory as DatabaseFactory;
+use Zynga\Framework\Database\V2\Config\Mock\Dev as MockDevConfig;
 use Zynga\Framework\Database\V2\Driver\Mock as MockDriver;
 use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
 use Zynga\Framework\Database\V2\Interfaces\DriverInterface;
@@ -140,4 +141,22 @@ class MockTest extends TestCase {
     }
   }
 
+  public function testQueryBatch(): void {
+
+    $mock = new MockDriver(new MockDevConfig());
+
+    $mock->addResultSet(Vector {Map {'id' => 1}});
+    $mock->addEmptyResultSet();
+
+    $results = $mock->queryBatch(
+      Vector {'SELECT id FROM t', 'UPDATE t SET a = 1'},
+      true,
+    );
+
+    $this->assertEquals(2, $results->count());
+    $this->assertEquals(1, $results[0]->getNumRows());
+    $this->assertEquals('UPDATE t SET a = 1', $results[1]->getSql());
+
+  }
+
 }
@@ -21,4 +21,70 @@ abstract class Base implements ResultSetInterface {
   public function errorCapture(): ErrorCaptureInterface {
     return $this->_errorCapture;
   }
+
+  /**
+   * Row at a time fallback, drivers override with their native bulk fetch.
+   */
+  public function fetchAllColumns(): Map<string, Vector<mixed>> {
+
+    $columns = Map {};
+
+    while ($this->next() === true) {
+      foreach ($this->fetchMap() as $name => $value) {
+        $column = $columns->get($name);
+        if ($column === null) {
+          $column = Vector {};
+          $columns->set($name, $column);
+        }
+        $column->add($value);
+      }
+    }
+
+    return $columns;
+
+  }
+
+  public function fetchAllVectors(): Vector<Vector<mixed>> {
+
+    $rows = Vector {};
+
+    while ($this->next() === true) {
+      $row = Vector {};
+      foreach ($this->fetchVector() as $value) {
+        $row->add($value);
+      }
+      $rows->add($row);
+    }
+
+    return $rows;
+
+  }
+
+  /**
+   * Pivots positional rows into per column vectors.
+   */
+  protected function pivotToColumns(
+    Vector<string> $columnNames,
+    Traversable<array<mixed>> $rows,
+  ): Map<string, Vector<mixed>> {
+
+    $columnData = Vector {};
+    foreach ($columnNames as $name) {
+      $columnData->add(Vector {});
+    }
+
+    foreach ($rows as $row) {
+      foreach ($row as $offset => $value) {
+        $columnData[$offset]->add($value);
+      }
+    }
+
+    $columns = Map {};
+    foreach ($columnNames as $offset => $name) {
+      $columns->set($name, $columnData[$offset]);
+    }
+
+    return $columns;
+
+  }
 }
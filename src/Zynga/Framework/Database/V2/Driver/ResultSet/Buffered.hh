@@ -0,0 +1,120 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Driver\ResultSet;
+
+use Zynga\Framework\Database\V2\Exceptions\OutOfBoundsForCursorException;
+
+/**
+ * Result set whose rows are already fully in memory, used where the
+ * underlying cursor can not be kept around (cached results, the statements
+ * of a batch). Rewind and re-reads are free.
+ *
+ * $numRows defaults to the row count, DML passes its affected row count.
+ */
+class Buffered extends Base {
+  private string $_sql;
+  private Vector<array<string, mixed>> $_rows;
+  private int $_numRows;
+  private int $_currentPosition;
+  private bool $_hasCursor;
+
+  public function __construct(
+    string $sql,
+    Vector<array<string, mixed>> $rows,
+    int $numRows = -1,
+  ) {
+
+    parent::__construct();
+
+    $this->_sql = $sql;
+    $this->_rows = $rows;
+    $this->_numRows = ($numRows >= 0) ? $numRows : $rows->count();
+    $this->_currentPosition = -1;
+    $this->_hasCursor = true;
+
+  }
+
+  public function wasSuccessful(): bool {
+    return true;
+  }
+
+  public function hasCursor(): bool {
+    return $this->_hasCursor;
+  }
+
+  public function freeCursor(): bool {
+    $this->_hasCursor = false;
+    return true;
+  }
+
+  public function setSql(string $sql): bool {
+    $this->_sql = $sql;
+    return true;
+  }
+
+  public function getSql(): string {
+    return $this->_sql;
+  }
+
+  public function wasSqlDML(): bool {
+    if (preg_match('/\s*(INSERT|UPDATE|DELETE)/i', $this->_sql)) {
+      return true;
+    }
+    return false;
+  }
+
+  public function getNumRows(): int {
+    return $this->_numRows;
+  }
+
+  public function rewind(int $pos): bool {
+    if ($pos < 0 || $pos > $this->_rows->count()) {
+      throw new OutOfBoundsForCursorException('OOB pos='.$pos);
+    }
+    $this->_currentPosition = $pos - 1;
+    return true;
+  }
+
+  public function hasMore(): bool {
+    return ($this->_currentPosition + 1) < $this->_rows->count();
+  }
+
+  public function next(): bool {
+    if ($this->hasMore() === true) {
+      $this->_currentPosition++;
+      return true;
+    }
+    return false;
+  }
+
+  public function fetchMap(): Map<string, mixed> {
+    $row = Map {};
+    foreach ($this->getCurrentRow() as $key => $value) {
+      $row->set($key, $value);
+    }
+    return $row;
+  }
+
+  public function fetchVector(): Vector<int> {
+    $row = Vector {};
+    foreach ($this->getCurrentRow() as $value) {
+      $row->add($value);
+    }
+    return $row;
+  }
+
+  public function getRows(): Vector<array<string, mixed>> {
+    return $this->_rows;
+  }
+
+  private function getCurrentRow(): array<string, mixed> {
+    $row = $this->_rows->get($this->_currentPosition);
+    if ($row === null) {
+      throw new OutOfBoundsForCursorException(
+        'No row at pos='.$this->_currentPosition,
+      );
+    }
+    return $row;
+  }
+
+}
@@ -0,0 +1,33 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\Driver\ResultSet;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Driver\ResultSet\Buffered;
+
+class BufferedTest extends TestCase {
+
+  public function test_rows(): void {
+
+    $rs = new Buffered('SELECT id FROM t', Vector {array('id' => 7)});
+
+    $this->assertFalse($rs->wasSqlDML());
+    $this->assertEquals(1, $rs->getNumRows());
+    $this->assertTrue($rs->next());
+    $this->assertEquals(Map {'id' => 7}, $rs->fetchMap());
+    $this->assertFalse($rs->hasMore());
+
+  }
+
+  public function test_affectedRows(): void {
+
+    $rs = new Buffered('UPDATE t SET a = 1', Vector {}, 5);
+
+    $this->assertTrue($rs->wasSqlDML());
+    $this->assertEquals(5, $rs->getNumRows());
+    $this->assertFalse($rs->next());
+
+  }
+
+}
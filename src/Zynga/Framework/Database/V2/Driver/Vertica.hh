@@ -8,6 +8,10 @@ use Zynga\Framework\Database\V2\Interfaces\QuoteInterface;
 use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
 
 use Zynga\Framework\Database\V2\Driver\Base;
+use Zynga\Framework\Database\V2\Driver\ResultSet\Buffered;
+use Zynga\Framework\Database\V2\Driver\Vertica\CopyEncoder;
+use Zynga\Framework\Database\V2\Driver\Vertica\CopyResult;
+use Zynga\Framework\Database\V2\Driver\Vertica\CursorResultSet;
 use Zynga\Framework\Database\V2\Driver\Vertica\ResultSet as VerticaResultSet;
 
 use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
@@ -21,6 +25,9 @@ use Zynga\Framework\Database\V2\Driver\Vertica\Transaction;
 use Zynga\Framework\Exception\V1\Exception;
 
 class Vertica extends Base {
+  const int DEFAULT_COPY_CHUNK_ROWS = 10000;
+  const int DEFAULT_COPY_CHUNK_BYTES = 8388608;
+
   private ?TransactionInterface $_transaction;
   private ?QuoteInterface $_quoter;
   private ?resource $_dbh;
@@ -177,25 +184,357 @@ class Vertica extends Base {
 
     $dbh = $this->_dbh;
 
+    $startTime = microtime(true);
+
     $this->errorCapture()->start();
 
-    // --
-    // Our older driver had this transaction isolation behavior.
-    // --
-    pg_query($dbh, "set transaction isolation level read uncommitted");
+    $this->setIsolationLevel($dbh);
 
     $rs = pg_query($dbh, $sql);
 
     $this->errorCapture()->stop();
 
     if (is_resource($rs)) {
-      return new VerticaResultSet($sql, $rs);
+      $resultSet = new VerticaResultSet($sql, $rs);
+      if ($this->hasQueryObservers() === true) {
+        $this->notifyQueryObservers(
+          $sql,
+          $startTime,
+          $resultSet->getNumRows(),
+          true,
+        );
+      }
+      return $resultSet;
     }
 
+    $this->notifyQueryObservers($sql, $startTime, 0, false);
+
     throw new QueryFailedException('QueryException: '.$this->getLastError());
 
   }
 
+  /**
+   * Sends the statements as one simple query protocol message and collects a
+   * result per statement with pg_get_result, one round trip for the batch.
+   * When atomic it is bracketed with BEGIN / COMMIT, the server aborts the
+   * rest of the batch on the first failure and we ROLLBACK behind it. Inside
+   * an already open transaction the bracket is left off, its COMMIT or
+   * ROLLBACK would end the caller's transaction.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<ResultSetInterface> {
+
+    $results = Vector {};
+
+    if ($statements->count() == 0) {
+      return $results;
+    }
+
+    if ($this->getRequiresMockQueries() === true) {
+      throw new MockQueriesRequired('queryBatch is not mockable');
+    }
+
+    if ($this->getIsConnected() !== true) {
+      $this->connect();
+    }
+
+    if ($this->_dbh === null) {
+      throw new ConnectionGoneAwayException(
+        'NO_CONNECTION host='.$this->getConfig()->getConnectionString(),
+      );
+    }
+
+    $dbh = $this->_dbh;
+
+    $isBracketed = $atomic === true && $this->isInTransaction($dbh) !== true;
+
+    $batch = $isBracketed === true
+      ? $this->prepareBatch($statements, 'BEGIN', 'COMMIT')
+      : $this->prepareBatch($statements);
+
+    $sql = implode(";\n", $batch);
+
+    $startTime = microtime(true);
+
+    $this->errorCapture()->start();
+
+    $sent = pg_send_query($dbh, $sql);
+
+    $error = $sent === true ? '' : $this->getLastError();
+    $offset = 0;
+    $numRows = 0;
+
+    while ($sent === true && ($rs = pg_get_result($dbh)) !== false) {
+
+      if (pg_result_status($rs) == PGSQL_FATAL_ERROR) {
+        if ($error === '') {
+          // Offsets are the caller's statements, the BEGIN does not count.
+          $statementOffset =
+            $isBracketed === true ? max(0, $offset - 1) : $offset;
+          $error =
+            'batch statement='.
+            $statementOffset.
+            ' error='.
+            pg_result_error($rs);
+        }
+        pg_free_result($rs);
+        continue;
+      }
+
+      $rows = Vector {};
+      $fetched = pg_fetch_all($rs);
+      if (is_array($fetched)) {
+        foreach ($fetched as $row) {
+          $rows->add($row);
+        }
+      }
+
+      $rowCount = pg_num_fields($rs) > 0
+        ? pg_num_rows($rs)
+        : pg_affected_rows($rs);
+      $numRows += $rowCount;
+
+      $results->add(new Buffered($batch[$offset], $rows, $rowCount));
+
+      pg_free_result($rs);
+
+      $offset++;
+
+    }
+
+    if ($error !== '' && $isBracketed === true) {
+      pg_query($dbh, 'ROLLBACK');
+    }
+
+    $this->errorCapture()->stop();
+
+    if ($error !== '') {
+      $this->recordError($error);
+      $this->notifyQueryObservers($sql, $startTime, 0, false);
+      throw new QueryFailedException('QueryException: '.$error);
+    }
+
+    $this->notifyQueryObservers($sql, $startTime, $numRows, true);
+
+    if ($isBracketed === true) {
+      // Drop the BEGIN / COMMIT results.
+      $results->removeKey(0);
+      $results->pop();
+    }
+
+    return $results;
+
+  }
+
+  /**
+   * libpq tracks the transaction state off the server's replies, so this also
+   * sees a transaction begun with plain SQL rather than getTransaction().
+   */
+  private function isInTransaction(resource $dbh): bool {
+    $status = pg_transaction_status($dbh);
+    return
+      $status == PGSQL_TRANSACTION_INTRANS ||
+      $status == PGSQL_TRANSACTION_INERROR;
+  }
+
+  /**
+   * Runs a select in LIMIT / OFFSET windows, rows come back $fetchRows at a
+   * time instead of the whole result being buffered by libpq. Use for large
+   * analytical reads, see CursorResultSet for the ORDER BY requirement and
+   * the row count caveat.
+   */
+  public function queryCursor(
+    string $sql,
+    int $fetchRows = CursorResultSet::DEFAULT_FETCH_ROWS,
+  ): ResultSetInterface {
+
+    if ($this->getRequiresMockQueries() === true &&
+        !preg_match('/(from|into)\s*dual/i', $sql)) {
+      throw new MockQueriesRequired(
+        'Your sql does not select from dual sql='.$sql,
+      );
+    }
+
+    if ($this->getIsConnected() !== true) {
+      $this->connect();
+    }
+
+    if ($this->_dbh === null) {
+      throw new ConnectionGoneAwayException(
+        'NO_CONNECTION host='.$this->getConfig()->getConnectionString(),
+      );
+    }
+
+    $dbh = $this->_dbh;
+
+    $startTime = microtime(true);
+
+    $this->errorCapture()->start();
+
+    $this->setIsolationLevel($dbh);
+
+    $this->errorCapture()->stop();
+
+    $resultSet = new CursorResultSet($sql, $dbh, $fetchRows);
+
+    if ($resultSet->open() !== true) {
+      $this->notifyQueryObservers($sql, $startTime, 0, false);
+      throw new QueryFailedException(
+        'QueryException: '.$this->getLastError(),
+      );
+    }
+
+    // Only the first window is known, observers see what open() read.
+    $this->notifyQueryObservers(
+      $sql,
+      $startTime,
+      $resultSet->getNumRows(),
+      true,
+    );
+
+    return $resultSet;
+
+  }
+
+  /**
+   * Bulk loads rows with COPY ... FROM STDIN over the existing connection.
+   *
+   * Rows are pulled off the traversable and sent in chunks of at most
+   * $chunkRows rows / DEFAULT_COPY_CHUNK_BYTES bytes, so a generator can feed
+   * millions of rows without them all being in memory. Each chunk is its own
+   * COPY, a failure part way leaves the earlier chunks loaded unless the call
+   * is wrapped in a transaction.
+   *
+   * @param string $table Table to load, optionally schema qualified
+   * @param Vector<string> $columns Columns in the order the row values are in
+   * @param Traversable<Traversable<mixed>> $rows The rows to load
+   * @param int $chunkRows Max rows per COPY
+   * @return CopyResult
+   */
+  public function copyFrom(
+    string $table,
+    Vector<string> $columns,
+    Traversable<Traversable<mixed>> $rows,
+    int $chunkRows = self::DEFAULT_COPY_CHUNK_ROWS,
+  ): CopyResult {
+
+    if ($this->getRequiresMockQueries() === true) {
+      throw new MockQueriesRequired('copyFrom is not mockable table='.$table);
+    }
+
+    if (!preg_match('/^[a-z_][a-z0-9_]*(\.[a-z_][a-z0-9_]*)?$/i', $table)) {
+      throw new QueryFailedException('Invalid table for copy table='.$table);
+    }
+
+    foreach ($columns as $column) {
+      if (!preg_match('/^[a-z_][a-z0-9_]*$/i', $column)) {
+        throw new QueryFailedException(
+          'Invalid column for copy column='.$column,
+        );
+      }
+    }
+
+    if ($chunkRows < 1) {
+      $chunkRows = 1;
+    }
+
+    $target = $table;
+    if ($columns->count() > 0) {
+      $target .= ' ('.implode(', ', $columns).')';
+    }
+
+    $result = new CopyResult();
+
+    $lines = array();
+    $bytes = 0;
+
+    foreach ($rows as $row) {
+
+      $line = CopyEncoder::encodeRow($row);
+
+      $lines[] = $line;
+      $bytes += strlen($line);
+
+      if (count($lines) >= $chunkRows ||
+          $bytes >= self::DEFAULT_COPY_CHUNK_BYTES) {
+        $this->copyChunk($target, $lines, $bytes, $result);
+        $lines = array();
+        $bytes = 0;
+      }
+
+    }
+
+    if (count($lines) > 0) {
+      $this->copyChunk($target, $lines, $bytes, $result);
+    }
+
+    return $result;
+
+  }
+
+  private function copyChunk(
+    string $target,
+    array<string> $lines,
+    int $bytes,
+    CopyResult $result,
+  ): void {
+
+    if ($this->getIsConnected() !== true) {
+      $this->connect();
+    }
+
+    if ($this->_dbh === null) {
+      throw new ConnectionGoneAwayException(
+        'NO_CONNECTION host='.$this->getConfig()->getConnectionString(),
+      );
+    }
+
+    $dbh = $this->_dbh;
+
+    $startTime = microtime(true);
+
+    $this->errorCapture()->start();
+
+    $success = pg_copy_from(
+      $dbh,
+      $target,
+      $lines,
+      CopyEncoder::DELIMITER,
+      CopyEncoder::NULL_VALUE,
+    );
+
+    $this->errorCapture()->stop();
+
+    $this->notifyQueryObservers(
+      'COPY '.$target.' FROM STDIN',
+      $startTime,
+      $success === true ? count($lines) : 0,
+      $success === true,
+    );
+
+    if ($success !== true) {
+      throw new QueryFailedException(
+        'CopyException: rowsLoaded='.
+        $result->getRowCount().
+        ' error='.
+        $this->getLastError(),
+      );
+    }
+
+    $result->addChunk(count($lines), $bytes, microtime(true) - $startTime);
+
+  }
+
+  /**
+   * Applied ahead of every read so plain and cursor queries see the same
+   * isolation. Our older driver had this transaction isolation behavior.
+   */
+  private function setIsolationLevel(resource $dbh): void {
+    pg_query($dbh, "set transaction isolation level read uncommitted");
+  }
+
   public function nativeQuoteString(string $value): string {
     $value = str_replace("'", "\\'", $value);
     return "'$value'";
@@ -0,0 +1,46 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+/**
+ * Turns rows into the tab delimited text format COPY ... FROM STDIN reads.
+ */
+class CopyEncoder {
+  const string DELIMITER = "\t";
+  const string NULL_VALUE = '\\N';
+
+  public static function encodeRow(Traversable<mixed> $row): string {
+    $values = array();
+    foreach ($row as $value) {
+      $values[] = self::encodeValue($value);
+    }
+    return implode(self::DELIMITER, $values)."\n";
+  }
+
+  public static function encodeValue(mixed $value): string {
+
+    if ($value === null) {
+      return self::NULL_VALUE;
+    }
+
+    if ($value === true) {
+      return 't';
+    }
+
+    if ($value === false) {
+      return 'f';
+    }
+
+    // Vertica's backslash makes the next character literal, so the real
+    // delimiter / record separator is escaped, not a \t style sequence
+    // (which would load as the letter). Backslash first, every other escape
+    // introduces one.
+    return str_replace(
+      array("\\", "\t", "\n", "\r"),
+      array("\\\\", "\\\t", "\\\n", "\\\r"),
+      strval($value),
+    );
+
+  }
+
+}
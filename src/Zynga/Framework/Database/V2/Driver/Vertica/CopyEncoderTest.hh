@@ -0,0 +1,31 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Driver\Vertica\CopyEncoder;
+
+class CopyEncoderTest extends TestCase {
+
+  public function test_encodeValue(): void {
+    $this->assertEquals('\\N', CopyEncoder::encodeValue(null));
+    $this->assertEquals('t', CopyEncoder::encodeValue(true));
+    $this->assertEquals('f', CopyEncoder::encodeValue(false));
+    $this->assertEquals('42', CopyEncoder::encodeValue(42));
+    $this->assertEquals('1.5', CopyEncoder::encodeValue(1.5));
+    $this->assertEquals(
+      "a\\\tb\\\nc\\\rd\\\\e",
+      CopyEncoder::encodeValue("a\tb\nc\rd\\e"),
+    );
+  }
+
+  public function test_encodeRow(): void {
+    $this->assertEquals(
+      "1\tbob\t\\N\n",
+      CopyEncoder::encodeRow(Vector {1, 'bob', null}),
+    );
+    $this->assertEquals("\n", CopyEncoder::encodeRow(Vector {}));
+  }
+
+}
@@ -0,0 +1,55 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+/**
+ * Outcome of a Vertica::copyFrom() load.
+ */
+class CopyResult {
+  private int $_rows;
+  private int $_chunks;
+  private int $_bytes;
+  private float $_elapsed;
+
+  public function __construct() {
+    $this->_rows = 0;
+    $this->_chunks = 0;
+    $this->_bytes = 0;
+    $this->_elapsed = 0.0;
+  }
+
+  public function addChunk(int $rows, int $bytes, float $elapsed): bool {
+    $this->_rows += $rows;
+    $this->_chunks++;
+    $this->_bytes += $bytes;
+    $this->_elapsed += $elapsed;
+    return true;
+  }
+
+  public function getRowCount(): int {
+    return $this->_rows;
+  }
+
+  public function getChunkCount(): int {
+    return $this->_chunks;
+  }
+
+  public function getByteCount(): int {
+    return $this->_bytes;
+  }
+
+  /**
+   * Time spent inside COPY, in seconds. Producing the rows is not counted.
+   */
+  public function getElapsed(): float {
+    return $this->_elapsed;
+  }
+
+  public function getRowsPerSecond(): float {
+    if ($this->_elapsed <= 0.0) {
+      return 0.0;
+    }
+    return $this->_rows / $this->_elapsed;
+  }
+
+}
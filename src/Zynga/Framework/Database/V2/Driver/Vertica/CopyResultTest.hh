@@ -0,0 +1,27 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Driver\Vertica\CopyResult;
+
+class CopyResultTest extends TestCase {
+
+  public function test_totals(): void {
+
+    $result = new CopyResult();
+    $this->assertEquals(0.0, $result->getRowsPerSecond());
+
+    $this->assertTrue($result->addChunk(100, 1000, 0.5));
+    $this->assertTrue($result->addChunk(50, 500, 0.25));
+
+    $this->assertEquals(150, $result->getRowCount());
+    $this->assertEquals(2, $result->getChunkCount());
+    $this->assertEquals(1500, $result->getByteCount());
+    $this->assertEquals(0.75, $result->getElapsed());
+    $this->assertEquals(200.0, $result->getRowsPerSecond());
+
+  }
+
+}
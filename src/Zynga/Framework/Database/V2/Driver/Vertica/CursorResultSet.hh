@@ -0,0 +1,314 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+use Zynga\Framework\Database\V2\Driver\ResultSet\Base;
+use Zynga\Framework\Database\V2\Exceptions\NoActiveCursorException;
+use Zynga\Framework\Database\V2\Exceptions\OutOfBoundsForCursorException;
+use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
+use Zynga\Framework\Exception\V1\Exception;
+
+/**
+ * Reads a query a window of rows at a time, so only getFetchRows() rows are
+ * ever resident on our side.
+ *
+ * Vertica has no DECLARE / FETCH cursors, each window is the query itself
+ * with 'LIMIT n OFFSET k' appended. The sql therefore has to be a single
+ * SELECT with an ORDER BY that gives every row a fixed place, and no LIMIT
+ * or OFFSET of its own. Every window is its own statement, rows written
+ * between two windows can shift the offsets, pin the query with AT EPOCH
+ * when that matters.
+ *
+ * Rewinding to a row that has already left the window reads the window
+ * starting at that row again.
+ *
+ * The total row count is not known up front, getNumRows() is the number of
+ * rows read so far and grows while iterating, it only becomes exact once
+ * hasMore() returns false. open() already reads the first window, so a count
+ * of 0 really does mean the result is empty.
+ */
+class CursorResultSet extends Base {
+  const int DEFAULT_FETCH_ROWS = 1000;
+
+  private string $_sql;
+  private ?resource $_dbh;
+  private int $_fetchRows;
+  private bool $_isOpen;
+  private bool $_isExhausted;
+
+  private Vector<array<string, mixed>> $_window;
+  private int $_windowStart;
+  private int $_currentPosition;
+  private int $_rowsRead;
+
+  public function __construct(
+    string $sql,
+    resource $dbh,
+    int $fetchRows = self::DEFAULT_FETCH_ROWS,
+  ) {
+
+    parent::__construct();
+
+    $this->_sql = $sql;
+    $this->_dbh = $dbh;
+    $this->_fetchRows = max(1, $fetchRows);
+    $this->_isOpen = false;
+    $this->_isExhausted = false;
+    $this->_window = Vector {};
+    $this->_windowStart = 0;
+    $this->_currentPosition = -1;
+    $this->_rowsRead = 0;
+
+  }
+
+  public function __destruct() {
+    $this->freeCursor();
+  }
+
+  /**
+   * Reads the first window, false if the query fails.
+   */
+  public function open(): bool {
+
+    if ($this->_dbh === null) {
+      return false;
+    }
+
+    $this->_isOpen = true;
+    $this->_isExhausted = false;
+    $this->_window = Vector {};
+    $this->_windowStart = 0;
+    $this->_currentPosition = -1;
+    $this->_rowsRead = 0;
+
+    try {
+      $this->fetchWindow();
+    } catch (QueryFailedException $e) {
+      $this->_isOpen = false;
+      return false;
+    }
+
+    return true;
+
+  }
+
+  public function getFetchRows(): int {
+    return $this->_fetchRows;
+  }
+
+  public function getResidentRowCount(): int {
+    return $this->_window->count();
+  }
+
+  public function wasSuccessful(): bool {
+    return $this->hasCursor();
+  }
+
+  public function hasCursor(): bool {
+    if ($this->_isOpen === true && is_resource($this->_dbh)) {
+      return true;
+    }
+    return false;
+  }
+
+  public function freeCursor(): bool {
+
+    if ($this->hasCursor() !== true || $this->_dbh === null) {
+      return false;
+    }
+
+    $this->_isOpen = false;
+    $this->_dbh = null;
+    $this->_window = Vector {};
+    $this->_currentPosition = -1;
+
+    return true;
+
+  }
+
+  public function setSql(string $sql): bool {
+    $this->_sql = $sql;
+    return true;
+  }
+
+  public function getSql(): string {
+    return $this->_sql;
+  }
+
+  public function wasSqlDML(): bool {
+    if (preg_match('/\s*(INSERT|UPDATE|DELETE)/i', $this->_sql)) {
+      return true;
+    }
+    return false;
+  }
+
+  public function getNumRows(): int {
+    if ($this->hasCursor() !== true) {
+      throw new NoActiveCursorException('NO_CURSOR');
+    }
+    return $this->_rowsRead;
+  }
+
+  public function rewind(int $pos): bool {
+
+    try {
+
+      if ($this->hasCursor() !== true) {
+        throw new NoActiveCursorException('NO_CURSOR');
+      }
+
+      if ($pos < 0 ||
+          ($this->_isExhausted === true && $pos > $this->_rowsRead)) {
+        throw new OutOfBoundsForCursorException('OOB');
+      }
+
+      // Behind the window the rows are gone, the next read starts over at
+      // $pos.
+      if ($pos < $this->_windowStart) {
+        $this->_window = Vector {};
+        $this->_windowStart = $pos;
+        $this->_isExhausted = false;
+      }
+
+      $this->_currentPosition = $pos - 1;
+
+      return true;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  public function hasMore(): bool {
+
+    try {
+
+      if ($this->hasCursor() !== true) {
+        throw new NoActiveCursorException('NO_CURSOR');
+      }
+
+      $target = $this->_currentPosition + 1;
+
+      while ($target >= $this->_windowStart + $this->_window->count()) {
+        if ($this->fetchWindow() !== true) {
+          return false;
+        }
+      }
+
+      return true;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  public function next(): bool {
+    try {
+      if ($this->hasMore() === true) {
+        $this->_currentPosition++;
+        return true;
+      }
+    } catch (Exception $e) {
+      throw $e;
+    }
+    return false;
+  }
+
+  public function fetchMap(): Map<string, mixed> {
+
+    $row = Map {};
+
+    foreach ($this->getCurrentRow() as $key => $value) {
+      $row->set($key, $value);
+    }
+
+    return $row;
+
+  }
+
+  public function fetchVector(): Vector<int> {
+
+    $vec = Vector {};
+
+    foreach ($this->getCurrentRow() as $value) {
+      $vec->add($value);
+    }
+
+    return $vec;
+
+  }
+
+  private function getCurrentRow(): array<string, mixed> {
+
+    if ($this->hasCursor() !== true) {
+      throw new NoActiveCursorException('NO_CURSOR');
+    }
+
+    $offset = $this->_currentPosition - $this->_windowStart;
+
+    if ($offset < 0 || $offset >= $this->_window->count()) {
+      return array();
+    }
+
+    return $this->_window[$offset];
+
+  }
+
+  /**
+   * Replaces the window with the rows following it, false once the result
+   * is dry.
+   */
+  private function fetchWindow(): bool {
+
+    if ($this->_isExhausted === true || $this->_dbh === null) {
+      return false;
+    }
+
+    $offset = $this->_windowStart + $this->_window->count();
+
+    $this->errorCapture()->start();
+
+    $rs = pg_query(
+      $this->_dbh,
+      rtrim($this->_sql, " \t\r\n;").
+      ' LIMIT '.
+      $this->_fetchRows.
+      ' OFFSET '.
+      $offset,
+    );
+
+    $this->errorCapture()->stop();
+
+    if (!is_resource($rs)) {
+      throw new QueryFailedException(
+        'Window read failed offset='.$offset.' sql='.$this->_sql,
+      );
+    }
+
+    $this->_windowStart = $offset;
+    $this->_window = Vector {};
+
+    $rows = pg_fetch_all($rs);
+
+    pg_free_result($rs);
+
+    if (is_array($rows)) {
+      foreach ($rows as $row) {
+        $this->_window->add($row);
+      }
+    }
+
+    $this->_rowsRead =
+      max($this->_rowsRead, $this->_windowStart + $this->_window->count());
+
+    if ($this->_window->count() < $this->_fetchRows) {
+      $this->_isExhausted = true;
+    }
+
+    return $this->_window->count() > 0;
+
+  }
+
+}
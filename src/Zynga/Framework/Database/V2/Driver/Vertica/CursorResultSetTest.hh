@@ -0,0 +1,120 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\Driver\Vertica;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Config\Test\Vertica\Dev as MockConfig;
+use Zynga\Framework\Database\V2\Driver\Vertica as VerticaDriver;
+use Zynga\Framework\Database\V2\Driver\Vertica\CursorResultSet;
+use Zynga\Framework\Database\V2\Exceptions\MockQueriesRequired;
+use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
+
+class CursorResultSetTest extends TestCase {
+  const int ROW_COUNT = 10;
+
+  private int $_stamp = 0;
+
+  public function setUp(): void {
+    parent::setUp();
+    $this->_stamp = time() + mt_rand(1, 100000);
+    $rows = Vector {};
+    for ($i = 0; $i < self::ROW_COUNT; $i++) {
+      $rows->add(Vector {$this->_stamp, $i});
+    }
+    $driver = new VerticaDriver(new MockConfig());
+    $driver->copyFrom(
+      'phpunit',
+      Vector {'unit_test_stamp', 'int_data'},
+      $rows,
+    );
+  }
+
+  public function tearDown(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $driver->query(
+      'DELETE FROM phpunit WHERE unit_test_stamp = '.$this->_stamp,
+    );
+    parent::tearDown();
+  }
+
+  private function getSql(): string {
+    return
+      'SELECT int_data FROM phpunit WHERE unit_test_stamp = '.
+      $this->_stamp.
+      ' ORDER BY int_data';
+  }
+
+  public function test_windowedRead(): void {
+
+    $driver = new VerticaDriver(new MockConfig());
+
+    $rs = $driver->queryCursor($this->getSql(), 3);
+
+    $this->assertTrue($rs instanceof CursorResultSet);
+    $this->assertTrue($rs->wasSuccessful());
+
+    // The first window is read up front, the count grows as we iterate.
+    $this->assertEquals(3, $rs->getNumRows());
+
+    $seen = Vector {};
+
+    while ($rs->next() === true) {
+      $seen->add(intval($rs->fetchMap()['int_data']));
+      if ($rs instanceof CursorResultSet) {
+        $this->assertTrue($rs->getResidentRowCount() <= 3);
+      }
+    }
+
+    $this->assertEquals(self::ROW_COUNT, $seen->count());
+    $this->assertEquals(0, $seen[0]);
+    $this->assertEquals(self::ROW_COUNT - 1, $seen[self::ROW_COUNT - 1]);
+    $this->assertEquals(self::ROW_COUNT, $rs->getNumRows());
+    $this->assertFalse($rs->hasMore());
+
+    // Row 1 left the window long ago, its window is read again.
+    $this->assertTrue($rs->rewind(1));
+    $this->assertTrue($rs->next());
+    $this->assertEquals(1, intval($rs->fetchVector()[0]));
+
+    $this->assertTrue($rs->freeCursor());
+    $this->assertFalse($rs->hasCursor());
+
+  }
+
+  public function test_emptyResult(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $rs = $driver->queryCursor(
+      'SELECT int_data FROM phpunit WHERE unit_test_stamp = -1',
+    );
+    $this->assertTrue($rs->wasSuccessful());
+    $this->assertEquals(0, $rs->getNumRows());
+    $this->assertFalse($rs->hasMore());
+  }
+
+  public function test_trailingSemicolon(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $rs = $driver->queryCursor($this->getSql().";\n", 4);
+    $this->assertEquals(self::ROW_COUNT, $rs->fetchAllVectors()->count());
+  }
+
+  public function test_fetchAllVectors(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $rs = $driver->queryCursor($this->getSql(), 4);
+    $this->assertEquals(self::ROW_COUNT, $rs->fetchAllVectors()->count());
+  }
+
+  public function test_brokenSql(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $this->expectException(QueryFailedException::class);
+    $driver->queryCursor('SELECT FROM invalidschema.invalidtablename');
+  }
+
+  public function test_notRespectingMock(): void {
+    $driver = new VerticaDriver(new MockConfig());
+    $driver->enableRequireMockQueries();
+    $this->expectException(MockQueriesRequired::class);
+    $driver->queryCursor($this->getSql());
+  }
+
+}
@@ -244,4 +244,76 @@ class ResultSet extends Base {
 
   }
 
+  /**
+   * A fresh result set is read a column at a time with pg_fetch_all_columns.
+   */
+  public function fetchAllColumns(): Map<string, Vector<mixed>> {
+
+    if ($this->_rs === null) {
+      throw new NoActiveCursorException('NO_CURSOR');
+    }
+
+    if ($this->_currentPosition != -1) {
+      return parent::fetchAllColumns();
+    }
+
+    $rs = $this->_rs;
+
+    $columns = Map {};
+
+    $this->errorCapture()->start();
+
+    $fieldCount = pg_num_fields($rs);
+
+    for ($offset = 0; $offset < $fieldCount; $offset++) {
+      $column = Vector {};
+      $values = pg_fetch_all_columns($rs, $offset);
+      if (is_array($values)) {
+        foreach ($values as $value) {
+          $column->add($value);
+        }
+      }
+      $columns->set(strval(pg_field_name($rs, $offset)), $column);
+    }
+
+    $this->errorCapture()->stop();
+
+    $this->_currentPosition = $this->getNumRows() - 1;
+
+    return $columns;
+
+  }
+
+  public function fetchAllVectors(): Vector<Vector<mixed>> {
+
+    if ($this->_rs === null) {
+      throw new NoActiveCursorException('NO_CURSOR');
+    }
+
+    if ($this->_currentPosition != -1) {
+      return parent::fetchAllVectors();
+    }
+
+    $rs = $this->_rs;
+
+    $rows = Vector {};
+
+    $this->errorCapture()->start();
+
+    $data = pg_fetch_all($rs);
+
+    $this->errorCapture()->stop();
+
+    if (is_array($data)) {
+      foreach ($data as $row) {
+        $rows->add(new Vector(array_values($row)));
+      }
+    }
+
+    $this->_currentPosition = $this->getNumRows() - 1;
+
+    return $rows;
+
+  }
+
 }
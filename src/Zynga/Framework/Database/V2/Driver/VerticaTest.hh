@@ -144,4 +144,164 @@ class VerticaTest extends TestCase {
 
   }
 
+  public function test_queryBatch_InsideOpenTransaction(): void {
+
+    $driver = new BaseDriver(new MockConfig());
+
+    $stamp = time();
+
+    $driver->getTransaction()->begin();
+
+    // No bracket of its own, so the caller's rollback still undoes it.
+    $driver->queryBatch(
+      Vector {
+        'INSERT INTO phpunit (unit_test_stamp, int_data) VALUES ('.
+        $stamp.
+        ', 1)',
+      },
+      true,
+    );
+
+    $driver->getTransaction()->rollback();
+
+    $rs = $driver->query(
+      'SELECT COUNT(*) AS cnt FROM phpunit WHERE unit_test_stamp = '.$stamp,
+    );
+    $rs->next();
+    $this->assertEquals(0, intval($rs->fetchMap()['cnt']));
+
+  }
+
+  public function test_queryBatch_FailureOffset(): void {
+
+    $driver = new BaseDriver(new MockConfig());
+
+    try {
+      $driver->queryBatch(
+        Vector {'SELECT 1', 'SELECT FROM phpunit_missing_table'},
+        true,
+      );
+      $this->fail('the second statement should fail');
+    } catch (QueryFailedException $e) {
+      $this->assertContains('batch statement=1 ', $e->getMessage());
+    }
+
+  }
+
+  public function test_copyFrom(): void {
+
+    $config = new MockConfig();
+    $driver = new BaseDriver($config);
+
+    $stamp = time();
+
+    $rows = Vector {};
+    for ($i = 0; $i < 25; $i++) {
+      $rows->add(Vector {$stamp, $i});
+    }
+
+    $result = $driver->copyFrom(
+      'phpunit',
+      Vector {'unit_test_stamp', 'int_data'},
+      $rows,
+      10,
+    );
+
+    $this->assertEquals(25, $result->getRowCount());
+    $this->assertEquals(3, $result->getChunkCount());
+    $this->assertTrue($result->getRowsPerSecond() > 0.0);
+
+    $rs = $driver->query(
+      'SELECT COUNT(*) AS cnt FROM phpunit WHERE unit_test_stamp = '.$stamp,
+    );
+    $rs->next();
+    $this->assertEquals(25, intval($rs->fetchMap()['cnt']));
+
+    $driver->query('DELETE FROM phpunit WHERE unit_test_stamp = '.$stamp);
+
+  }
+
+  public function test_copyFrom_NullColumn(): void {
+
+    $driver = new BaseDriver(new MockConfig());
+
+    $stamp = time();
+
+    $result = $driver->copyFrom(
+      'phpunit',
+      Vector {'unit_test_stamp', 'int_data'},
+      Vector {Vector {$stamp, null}, Vector {$stamp, 7}},
+    );
+
+    $this->assertEquals(2, $result->getRowCount());
+
+    $rs = $driver->query(
+      'SELECT COUNT(*) AS cnt FROM phpunit WHERE unit_test_stamp = '.
+      $stamp.
+      ' AND int_data IS NULL',
+    );
+    $rs->next();
+    $this->assertEquals(1, intval($rs->fetchMap()['cnt']));
+
+    $driver->query('DELETE FROM phpunit WHERE unit_test_stamp = '.$stamp);
+
+  }
+
+  public function test_copyFrom_RoundTripsSpecialCharacters(): void {
+
+    $driver = new BaseDriver(new MockConfig());
+
+    // The test table only holds numbers, the text column lives in a session
+    // table on the same connection.
+    $driver->query(
+      'CREATE LOCAL TEMPORARY TABLE phpunit_copy (id INT, string_data '.
+      'VARCHAR(64)) ON COMMIT PRESERVE ROWS',
+    );
+
+    $values = Vector {
+      "tab\there",
+      "new\nline",
+      "carriage\rreturn",
+      'back\\slash',
+    };
+
+    $rows = Vector {};
+    foreach ($values as $id => $value) {
+      $rows->add(Vector {$id, $value});
+    }
+
+    $driver->copyFrom('phpunit_copy', Vector {'id', 'string_data'}, $rows);
+
+    $rs = $driver->query('SELECT id, string_data FROM phpunit_copy ORDER BY id');
+
+    $seen = Vector {};
+    while ($rs->next()) {
+      $seen->add(strval($rs->fetchMap()['string_data']));
+    }
+
+    $driver->query('DROP TABLE phpunit_copy');
+
+    $this->assertEquals($values, $seen);
+
+  }
+
+  public function test_copyFrom_InvalidTable(): void {
+    $driver = new BaseDriver(new MockConfig());
+    $this->expectException(QueryFailedException::class);
+    $driver->copyFrom('phpunit; DROP TABLE phpunit', Vector {}, Vector {});
+  }
+
+  public function test_copyFrom_InvalidColumn(): void {
+    $driver = new BaseDriver(new MockConfig());
+    $this->expectException(QueryFailedException::class);
+    $driver->copyFrom('phpunit', Vector {'int_data)'}, Vector {});
+  }
+
+  public function test_copyFrom_NotRespectingMock(): void {
+    $driver = new BaseDriver(new MockConfig());
+    $driver->enableRequireMockQueries();
+    $this->expectException(MockQueriesRequired::class);
+    $driver->copyFrom('phpunit', Vector {}, Vector {});
+  }
+
 }
@@ -0,0 +1,7 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Exceptions;
+
+use Zynga\Framework\Exception\V1\Exception;
+
+class ResultCacheRequiresReadOnlyException extends Exception {}
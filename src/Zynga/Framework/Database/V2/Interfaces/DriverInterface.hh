@@ -3,6 +3,7 @@
 namespace Zynga\Framework\Database\V2\Interfaces;
 
 use Zynga\Framework\Database\V2\Interfaces\DriverConfigInterface;
+use Zynga\Framework\Database\V2\Interfaces\QueryObserverInterface;
 use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
 
 use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
@@ -18,4 +19,8 @@ interface DriverInterface extends FactoryDriverInterface, QueryableInterface {
 
   public function getConfig(): DriverConfigInterface;
 
+  public function addQueryObserver(QueryObserverInterface $observer): bool;
+  public function getQueryObservers(): Vector<QueryObserverInterface>;
+  public function clearQueryObservers(): bool;
+
 }
@@ -0,0 +1,23 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\Interfaces;
+
+interface QueryObserverInterface {
+
+  /**
+   * Called by the driver after every query, successful or not.
+   *
+   * @param string $sql The sql as it was sent to the server
+   * @param float $elapsed Wall clock time the query took, in seconds
+   * @param int $numRows Rows returned or affected, 0 on failure
+   * @param bool $wasSuccessful False if the query raised
+   * @return bool
+   */
+  public function observe(
+    string $sql,
+    float $elapsed,
+    int $numRows,
+    bool $wasSuccessful,
+  ): bool;
+
+}
@@ -15,6 +15,18 @@ interface QueryableInterface {
    */
   public function query(string $sql): ResultSetInterface;
 
+  /**
+   * Runs several statements in as few round trips as the driver allows,
+   * returning one fully buffered result per statement, in order.
+   * @param Vector<string> $statements
+   * @param bool $atomic wrap the statements in a single transaction
+   * @return Vector<ResultSetInterface>
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<ResultSetInterface>;
+
   /**
    * Attempts to connect to a given database type.
    * @return bool result of connection.
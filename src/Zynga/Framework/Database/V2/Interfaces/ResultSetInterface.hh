@@ -28,4 +28,16 @@ interface ResultSetInterface {
   public function fetchMap(): Map<string, mixed>;
   public function fetchVector(): Vector<int>;
 
+  /**
+   * Bulk fetch of every row past the current position, keyed by column name.
+   * Leaves the cursor at the end of the result set.
+   */
+  public function fetchAllColumns(): Map<string, Vector<mixed>>;
+
+  /**
+   * Bulk fetch of every row past the current position as positional rows.
+   * Leaves the cursor at the end of the result set.
+   */
+  public function fetchAllVectors(): Vector<Vector<mixed>>;
+
 }
@@ -0,0 +1,220 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\QueryObserver;
+
+use Zynga\Framework\Database\V2\Interfaces\QueryObserverInterface;
+use
+  Zynga\Framework\Datadog\V2\Interfaces\DriverInterface as DatadogDriverInterface
+;
+use Zynga\Framework\Logging\V1\StaticLogger;
+
+/**
+ * Groups queries by sql shape and keeps latency / row stats per shape.
+ *
+ * Only a sampled fraction of queries feed the stats, but every query slower
+ * than the slow threshold is written to the slow query log, sampled or not.
+ * Stats leave the process through exportToLog() or exportToDatadog(),
+ * typically once at the end of a request or batch.
+ */
+class ShapeObserver implements QueryObserverInterface {
+  const float DEFAULT_SAMPLE_RATE = 1.0;
+  const float DEFAULT_SLOW_QUERY_MS = 1000.0;
+  const int DEFAULT_MAX_SHAPES = 500;
+  const string DEFAULT_LOG_CONTEXT = 'default';
+
+  private Map<string, ShapeStats> $_shapes;
+  private float $_sampleRate;
+  private float $_slowQueryMs;
+  private int $_maxShapes;
+  private string $_logContext;
+  private int $_slowQueries;
+  private int $_droppedShapes;
+
+  public function __construct() {
+    $this->_shapes = Map {};
+    $this->_sampleRate = self::DEFAULT_SAMPLE_RATE;
+    $this->_slowQueryMs = self::DEFAULT_SLOW_QUERY_MS;
+    $this->_maxShapes = self::DEFAULT_MAX_SHAPES;
+    $this->_logContext = self::DEFAULT_LOG_CONTEXT;
+    $this->_slowQueries = 0;
+    $this->_droppedShapes = 0;
+  }
+
+  public function getSampleRate(): float {
+    return $this->_sampleRate;
+  }
+
+  /**
+   * Fraction (0-1) of queries that are folded into the per shape stats.
+   */
+  public function setSampleRate(float $sampleRate): bool {
+    $this->_sampleRate = max(0.0, min(1.0, $sampleRate));
+    return true;
+  }
+
+  public function getSlowQueryMs(): float {
+    return $this->_slowQueryMs;
+  }
+
+  public function setSlowQueryMs(float $slowQueryMs): bool {
+    $this->_slowQueryMs = $slowQueryMs;
+    return true;
+  }
+
+  public function getMaxShapes(): int {
+    return $this->_maxShapes;
+  }
+
+  /**
+   * Caps how many distinct shapes are tracked, queries built with unbounded
+   * variety (eg. dynamic column lists) should not grow memory forever.
+   */
+  public function setMaxShapes(int $maxShapes): bool {
+    $this->_maxShapes = $maxShapes;
+    return true;
+  }
+
+  public function getLogContext(): string {
+    return $this->_logContext;
+  }
+
+  public function setLogContext(string $logContext): bool {
+    $this->_logContext = $logContext;
+    return true;
+  }
+
+  public function getSlowQueryCount(): int {
+    return $this->_slowQueries;
+  }
+
+  public function getDroppedShapeCount(): int {
+    return $this->_droppedShapes;
+  }
+
+  public function getShapeStats(): Map<string, ShapeStats> {
+    return $this->_shapes->toMap();
+  }
+
+  public function observe(
+    string $sql,
+    float $elapsed,
+    int $numRows,
+    bool $wasSuccessful,
+  ): bool {
+
+    $elapsedMs = $elapsed * 1000;
+    $isSlow = $elapsedMs >= $this->_slowQueryMs;
+
+    if ($isSlow !== true && $this->shouldSample() !== true) {
+      return false;
+    }
+
+    // Normalizing is the expensive part, only pay for it when needed.
+    $shape = SqlShape::normalize($sql);
+
+    if ($isSlow === true) {
+      $this->_slowQueries++;
+      StaticLogger::warning(
+        'slow query',
+        Map {
+          'shape' => $shape,
+          'id' => SqlShape::getId($shape),
+          'elapsed_ms' => round($elapsedMs, 3),
+          'rows' => $numRows,
+          'success' => $wasSuccessful,
+        },
+        false,
+        $this->_logContext,
+      );
+      if ($this->shouldSample() !== true) {
+        return true;
+      }
+    }
+
+    $stats = $this->_shapes->get($shape);
+
+    if ($stats === null) {
+      if ($this->_shapes->count() >= $this->_maxShapes) {
+        $this->_droppedShapes++;
+        return false;
+      }
+      $stats = new ShapeStats($shape);
+      $this->_shapes->set($shape, $stats);
+    }
+
+    return $stats->record($elapsedMs, $numRows, $wasSuccessful);
+
+  }
+
+  public function reset(): bool {
+    $this->_shapes->clear();
+    $this->_slowQueries = 0;
+    $this->_droppedShapes = 0;
+    return true;
+  }
+
+  /**
+   * Writes one info line per shape to Logging V1.
+   */
+  public function exportToLog(): bool {
+    foreach ($this->_shapes as $stats) {
+      StaticLogger::info('query shape', $stats->toMap(), false, $this->_logContext);
+    }
+    return true;
+  }
+
+  /**
+   * Sends per shape counters and latency figures to Datadog V2, tagged with
+   * the shape id. Counts cover sampled queries only.
+   */
+  public function exportToDatadog(
+    DatadogDriverInterface $dog,
+    string $prefix = 'database.query',
+    ?Map<string, string> $tags = null,
+  ): bool {
+
+    foreach ($this->_shapes as $stats) {
+
+      $shapeTags = Map {'query_shape' => $stats->getId()};
+      if ($tags !== null) {
+        $shapeTags->setAll($tags);
+      }
+
+      $dog->gauge($prefix.'.count', (float) $stats->getCount(), 1.0, $shapeTags);
+      $dog->gauge($prefix.'.rows', (float) $stats->getRowCount(), 1.0, $shapeTags);
+      $dog->gauge(
+        $prefix.'.failures',
+        (float) $stats->getFailureCount(),
+        1.0,
+        $shapeTags,
+      );
+      $dog->gauge($prefix.'.avg_ms', $stats->getAverageMs(), 1.0, $shapeTags);
+      $dog->gauge(
+        $prefix.'.p95_ms',
+        $stats->getPercentileMs(95.0),
+        1.0,
+        $shapeTags,
+      );
+      $dog->gauge($prefix.'.max_ms', $stats->getMaxMs(), 1.0, $shapeTags);
+
+    }
+
+    if ($this->_slowQueries > 0) {
+      $dog->gauge($prefix.'.slow', (float) $this->_slowQueries, 1.0, $tags);
+    }
+
+    return true;
+
+  }
+
+  protected function shouldSample(): bool {
+    if ($this->_sampleRate >= 1.0) {
+      return true;
+    }
+    if ($this->_sampleRate <= 0.0) {
+      return false;
+    }
+    return (mt_rand() / mt_getrandmax()) < $this->_sampleRate;
+  }
+
+}
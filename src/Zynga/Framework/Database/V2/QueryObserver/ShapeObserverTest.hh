@@ -0,0 +1,161 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\QueryObserver;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Config\Mock\Cluster\Dev as DevCluster;
+use Zynga\Framework\Database\V2\Driver\Mock as MockDriver;
+use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
+use Zynga\Framework\Database\V2\QueryObserver\ShapeObserver;
+use Zynga\Framework\Database\V2\QueryObserver\ShapeStats;
+use Zynga\Framework\Datadog\V2\Factory as DatadogFactory;
+use
+  Zynga\Framework\Datadog\V2\Interfaces\DriverInterface as DatadogDriverInterface
+;
+
+class ShapeObserverTest extends TestCase {
+  const string LOG_CONTEXT = 'Noop';
+
+  private function createObserver(): ShapeObserver {
+    $observer = new ShapeObserver();
+    $observer->setLogContext(self::LOG_CONTEXT);
+    return $observer;
+  }
+
+  public function test_groupsByShape(): void {
+
+    $observer = $this->createObserver();
+
+    $this->assertTrue($observer->observe('SELECT * FROM t WHERE id = 1', 0.002, 1, true));
+    $this->assertTrue($observer->observe('SELECT * FROM t WHERE id = 2', 0.004, 1, true));
+    $this->assertTrue($observer->observe('SELECT * FROM u', 0.0005, 10, false));
+
+    $shapes = $observer->getShapeStats();
+    $this->assertEquals(2, $shapes->count());
+
+    $stats = $shapes['select * from t where id = ?'];
+    $this->assertEquals(2, $stats->getCount());
+    $this->assertEquals(2, $stats->getRowCount());
+    $this->assertEquals(0, $stats->getFailureCount());
+    $this->assertEquals(3.0, round($stats->getAverageMs(), 3));
+    $this->assertEquals(4.0, round($stats->getMaxMs(), 3));
+
+    $this->assertEquals(1, $shapes['select * from u']->getFailureCount());
+
+    $this->assertTrue($observer->reset());
+    $this->assertEquals(0, $observer->getShapeStats()->count());
+
+  }
+
+  public function test_histogram(): void {
+
+    $stats = new ShapeStats('select ?');
+
+    $this->assertEquals(0.0, $stats->getPercentileMs(95.0));
+
+    for ($i = 0; $i < 90; $i++) {
+      $stats->record(0.5, 1, true);
+    }
+    for ($i = 0; $i < 10; $i++) {
+      $stats->record(40.0, 1, true);
+    }
+
+    $buckets = $stats->getBuckets();
+    $this->assertEquals(count(ShapeStats::BUCKET_BOUNDS_MS) + 1, $buckets->count());
+    $this->assertEquals(90, $buckets[0]);
+    $this->assertEquals(10, $buckets[5]);
+
+    $this->assertEquals(1.0, $stats->getPercentileMs(50.0));
+    $this->assertEquals(40.0, $stats->getPercentileMs(95.0));
+
+    // Past the last bound only the observed max is known.
+    $stats->record(60000.0, 1, true);
+    $this->assertEquals(60000.0, $stats->getPercentileMs(100.0));
+
+  }
+
+  public function test_slowQueriesBypassSampling(): void {
+
+    $observer = $this->createObserver();
+    $this->assertTrue($observer->setSampleRate(0.0));
+    $this->assertTrue($observer->setSlowQueryMs(100.0));
+
+    $this->assertFalse($observer->observe('SELECT 1', 0.001, 1, true));
+    $this->assertEquals(0, $observer->getSlowQueryCount());
+
+    $this->assertTrue($observer->observe('SELECT 1', 0.5, 1, true));
+    $this->assertEquals(1, $observer->getSlowQueryCount());
+
+    // Logged, but not folded into the sampled stats.
+    $this->assertEquals(0, $observer->getShapeStats()->count());
+
+  }
+
+  public function test_sampleRateClamped(): void {
+    $observer = $this->createObserver();
+    $this->assertTrue($observer->setSampleRate(5.0));
+    $this->assertEquals(1.0, $observer->getSampleRate());
+    $this->assertTrue($observer->setSampleRate(-1.0));
+    $this->assertEquals(0.0, $observer->getSampleRate());
+  }
+
+  public function test_maxShapes(): void {
+
+    $observer = $this->createObserver();
+    $this->assertTrue($observer->setMaxShapes(1));
+
+    $this->assertTrue($observer->observe('SELECT a FROM t', 0.001, 1, true));
+    $this->assertFalse($observer->observe('SELECT b FROM t', 0.001, 1, true));
+    $this->assertTrue($observer->observe('SELECT a FROM t', 0.001, 1, true));
+
+    $this->assertEquals(1, $observer->getShapeStats()->count());
+    $this->assertEquals(1, $observer->getDroppedShapeCount());
+
+  }
+
+  public function test_export(): void {
+
+    $observer = $this->createObserver();
+    $observer->setSlowQueryMs(1.0);
+    $observer->observe('SELECT * FROM t WHERE id = 1', 0.002, 1, true);
+
+    $this->assertTrue($observer->exportToLog());
+
+    $dog = DatadogFactory::factory(DatadogDriverInterface::class, 'Mock');
+    $this->assertTrue($observer->exportToDatadog($dog));
+    $this->assertTrue($observer->exportToDatadog($dog, 'db', Map {'env' => 'dev'}));
+
+  }
+
+  public function test_driverNotifies(): void {
+
+    $observer = $this->createObserver();
+
+    $driver = new MockDriver(new DevCluster());
+    $this->assertTrue($driver->addQueryObserver($observer));
+    $this->assertEquals(1, $driver->getQueryObservers()->count());
+
+    $driver->addResultSet(Vector {Map {'id' => 1}, Map {'id' => 2}});
+    $driver->addFailingResultSet();
+
+    $driver->query('SELECT id FROM t WHERE user_id = 12');
+
+    try {
+      $driver->query('SELECT id FROM t WHERE user_id = 13');
+      $this->fail('failing result set should throw');
+    } catch (QueryFailedException $e) {
+      // expected
+    }
+
+    $stats = $observer->getShapeStats()['select id from t where user_id = ?'];
+    $this->assertEquals(2, $stats->getCount());
+    $this->assertEquals(2, $stats->getRowCount());
+    $this->assertEquals(1, $stats->getFailureCount());
+
+    $this->assertTrue($driver->clearQueryObservers());
+    $this->assertEquals(0, $driver->getQueryObservers()->count());
+
+  }
+
+}
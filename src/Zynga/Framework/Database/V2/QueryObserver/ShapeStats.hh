@@ -0,0 +1,141 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\QueryObserver;
+
+/**
+ * Running totals for a single sql shape. Latency is kept as counts against
+ * fixed millisecond bucket bounds, so memory stays constant no matter how
+ * often the shape runs.
+ */
+class ShapeStats {
+
+  // Upper bounds in ms, anything slower lands in the final overflow bucket.
+  const array<int> BUCKET_BOUNDS_MS =
+    array(1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000);
+
+  private string $_shape;
+  private string $_id;
+  private int $_count;
+  private int $_failures;
+  private int $_rows;
+  private float $_totalMs;
+  private float $_maxMs;
+  private Vector<int> $_buckets;
+
+  public function __construct(string $shape) {
+    $this->_shape = $shape;
+    $this->_id = SqlShape::getId($shape);
+    $this->_count = 0;
+    $this->_failures = 0;
+    $this->_rows = 0;
+    $this->_totalMs = 0.0;
+    $this->_maxMs = 0.0;
+    $this->_buckets = Vector {};
+    $this->_buckets->resize(count(self::BUCKET_BOUNDS_MS) + 1, 0);
+  }
+
+  public function record(float $elapsedMs, int $numRows, bool $wasSuccessful): bool {
+
+    $this->_count++;
+    $this->_rows += $numRows;
+    $this->_totalMs += $elapsedMs;
+
+    if ($elapsedMs > $this->_maxMs) {
+      $this->_maxMs = $elapsedMs;
+    }
+
+    if ($wasSuccessful !== true) {
+      $this->_failures++;
+    }
+
+    $bucket = 0;
+    foreach (self::BUCKET_BOUNDS_MS as $bound) {
+      if ($elapsedMs <= $bound) {
+        break;
+      }
+      $bucket++;
+    }
+    $this->_buckets[$bucket]++;
+
+    return true;
+
+  }
+
+  public function getShape(): string {
+    return $this->_shape;
+  }
+
+  public function getId(): string {
+    return $this->_id;
+  }
+
+  public function getCount(): int {
+    return $this->_count;
+  }
+
+  public function getFailureCount(): int {
+    return $this->_failures;
+  }
+
+  public function getRowCount(): int {
+    return $this->_rows;
+  }
+
+  public function getTotalMs(): float {
+    return $this->_totalMs;
+  }
+
+  public function getMaxMs(): float {
+    return $this->_maxMs;
+  }
+
+  public function getAverageMs(): float {
+    if ($this->_count == 0) {
+      return 0.0;
+    }
+    return $this->_totalMs / $this->_count;
+  }
+
+  public function getBuckets(): Vector<int> {
+    return $this->_buckets->toVector();
+  }
+
+  /**
+   * Upper bound of the bucket holding the given percentile (0-100), capped at
+   * the observed max so the overflow bucket still reports something real.
+   */
+  public function getPercentileMs(float $percentile): float {
+
+    if ($this->_count == 0) {
+      return 0.0;
+    }
+
+    $target = (int) ceil($this->_count * ($percentile / 100));
+    $seen = 0;
+
+    foreach ($this->_buckets as $bucket => $bucketCount) {
+      $seen += $bucketCount;
+      if ($seen >= $target && $bucket < count(self::BUCKET_BOUNDS_MS)) {
+        return min((float) self::BUCKET_BOUNDS_MS[$bucket], $this->_maxMs);
+      }
+    }
+
+    return $this->_maxMs;
+
+  }
+
+  public function toMap(): Map<string, mixed> {
+    return Map {
+      'shape' => $this->_shape,
+      'id' => $this->_id,
+      'count' => $this->_count,
+      'failures' => $this->_failures,
+      'rows' => $this->_rows,
+      'avg_ms' => round($this->getAverageMs(), 3),
+      'p95_ms' => $this->getPercentileMs(95.0),
+      'max_ms' => round($this->_maxMs, 3),
+      'buckets' => $this->getBuckets(),
+    };
+  }
+
+}
@@ -0,0 +1,48 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\QueryObserver;
+
+/**
+ * Reduces sql to its shape, literals become ? so every query that differs
+ * only by the values it was run with groups together.
+ */
+class SqlShape {
+
+  public static function normalize(string $sql): string {
+
+    $shape = preg_replace(
+      array(
+        // quoted strings, honoring backslash and doubled quote escapes.
+        "/'(?:[^'\\\\]|\\\\.|'')*'/s",
+        '/"(?:[^"\\\\]|\\\\.|"")*"/s',
+        // hex and plain numbers that are not part of an identifier.
+        '/\b0x[0-9a-f]+\b/i',
+        '/(?<![\w.])-?\d+(?:\.\d+)?(?:e[+-]?\d+)?\b/i',
+        '/\s+/',
+      ),
+      array('?', '?', '?', '?', ' '),
+      $sql,
+    );
+
+    // IN (?, ?, ?) and multi row VALUES lists collapse to a single entry.
+    $shape = preg_replace(
+      array(
+        '/\(\s*\?(?:\s*,\s*\?)*\s*\)/',
+        '/(\(\?\))(?:\s*,\s*\(\?\))+/',
+      ),
+      array('(?)', '$1'),
+      $shape,
+    );
+
+    return strtolower(trim($shape));
+
+  }
+
+  /**
+   * Short stable id for a shape, suitable for a metric tag.
+   */
+  public static function getId(string $shape): string {
+    return sprintf('%08x', crc32($shape));
+  }
+
+}
@@ -0,0 +1,55 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\QueryObserver;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\QueryObserver\SqlShape;
+
+class SqlShapeTest extends TestCase {
+
+  public function test_literalsStripped(): void {
+    $this->assertEquals(
+      'select * from users where id = ? and name = ?',
+      SqlShape::normalize("SELECT *  FROM users\n WHERE id = 1234 AND name = 'o\\'brien'"),
+    );
+    $this->assertEquals(
+      'select * from t where a = ? and b = ? and c = ?',
+      SqlShape::normalize('SELECT * FROM t WHERE a = -1.5 AND b = 0xFF AND c = "x"'),
+    );
+  }
+
+  public function test_identifiersWithDigitsKept(): void {
+    $this->assertEquals(
+      'select col1 from table_2 where t2.id = ?',
+      SqlShape::normalize('SELECT col1 FROM table_2 WHERE t2.id = 7'),
+    );
+  }
+
+  public function test_listsCollapsed(): void {
+
+    $this->assertEquals(
+      'select * from t where id in (?)',
+      SqlShape::normalize('SELECT * FROM t WHERE id IN (1, 2, 3)'),
+    );
+
+    $this->assertEquals(
+      SqlShape::normalize('SELECT * FROM t WHERE id IN (1)'),
+      SqlShape::normalize('SELECT * FROM t WHERE id IN (4,5,6,7,8)'),
+    );
+
+    $this->assertEquals(
+      'insert into t (a, b) values (?)',
+      SqlShape::normalize("INSERT INTO t (a, b) VALUES (1, 'x'), (2, 'y')"),
+    );
+
+  }
+
+  public function test_getId(): void {
+    $id = SqlShape::getId('select ?');
+    $this->assertEquals(8, strlen($id));
+    $this->assertEquals($id, SqlShape::getId('select ?'));
+    $this->assertNotEquals($id, SqlShape::getId('select ? from dual'));
+  }
+
+}
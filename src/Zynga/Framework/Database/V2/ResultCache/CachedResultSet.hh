@@ -0,0 +1,19 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\ResultCache;
+
+use Zynga\Framework\Database\V2\Driver\ResultSet\Buffered;
+
+/**
+ * Replays rows that were captured from a real result set.
+ */
+class CachedResultSet extends Buffered {
+
+  public function __construct(
+    string $sql,
+    Vector<array<string, mixed>> $rows,
+  ) {
+    parent::__construct($sql, $rows);
+  }
+
+}
@@ -0,0 +1,56 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\ResultCache;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Database\V2\Exceptions\OutOfBoundsForCursorException;
+use Zynga\Framework\Database\V2\ResultCache\CachedResultSet;
+
+class CachedResultSetTest extends TestCase {
+
+  private function createResultSet(): CachedResultSet {
+    return new CachedResultSet(
+      'SELECT id, name FROM t',
+      Vector {
+        array('id' => 1, 'name' => 'one'),
+        array('id' => 2, 'name' => 'two'),
+      },
+    );
+  }
+
+  public function test_replay(): void {
+
+    $rs = $this->createResultSet();
+
+    $this->assertTrue($rs->wasSuccessful());
+    $this->assertFalse($rs->wasSqlDML());
+    $this->assertEquals(2, $rs->getNumRows());
+
+    $this->assertTrue($rs->next());
+    $this->assertEquals(Map {'id' => 1, 'name' => 'one'}, $rs->fetchMap());
+    $this->assertTrue($rs->next());
+    $this->assertEquals(Vector {2, 'two'}, $rs->fetchVector());
+    $this->assertFalse($rs->next());
+
+    $this->assertTrue($rs->rewind(0));
+    $this->assertEquals(2, $rs->fetchAllVectors()->count());
+
+    $this->assertTrue($rs->freeCursor());
+    $this->assertFalse($rs->hasCursor());
+
+  }
+
+  public function test_outOfBounds(): void {
+    $rs = $this->createResultSet();
+    $this->expectException(OutOfBoundsForCursorException::class);
+    $rs->rewind(3);
+  }
+
+  public function test_fetchBeforeNext(): void {
+    $rs = $this->createResultSet();
+    $this->expectException(OutOfBoundsForCursorException::class);
+    $rs->fetchMap();
+  }
+
+}
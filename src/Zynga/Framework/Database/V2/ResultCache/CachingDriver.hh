@@ -0,0 +1,328 @@
+<?hh // strict
+
+namespace Zynga\Framework\Database\V2\ResultCache;
+
+use Zynga\Framework\Cache\V2\Interfaces\MemcacheDriverInterface;
+use Zynga\Framework\Database\V2\Exceptions\ResultCacheRequiresReadOnlyException;
+use Zynga\Framework\Database\V2\Interfaces\DriverInterface;
+use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
+use Zynga\Framework\Database\V2\Interfaces\QuoteInterface;
+use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
+use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
+use Zynga\Framework\Database\V2\ResultCache\CachedResultSet;
+use Zynga\Framework\Exception\V1\Exception;
+
+/**
+ * Wraps a read-only driver and serves repeated SELECTs out of a Cache V2
+ * driver, keyed by a hash of the config and sql.
+ *
+ * Every entry records the version of each table it read from. Bumping a
+ * table with invalidateTable() changes its version, so entries built on the
+ * old version stop matching without having to be found and deleted. Tables
+ * are pulled from the FROM / JOIN clauses, or given by queryWithTables().
+ *
+ * Anything that is not a SELECT goes straight to the wrapped driver.
+ */
+class CachingDriver implements QueryableInterface {
+  const int DEFAULT_TTL = 300;
+  const int DEFAULT_MAX_ROWS = 10000;
+  const string KEY_PREFIX = 'dbrc';
+
+  private DriverInterface $_driver;
+  private MemcacheDriverInterface $_cache;
+  private int $_ttl;
+  private int $_maxRows;
+  private string $_namespace;
+  private int $_hits;
+  private int $_misses;
+
+  public function __construct(
+    DriverInterface $driver,
+    MemcacheDriverInterface $cache,
+    int $ttl = self::DEFAULT_TTL,
+  ) {
+
+    $config = $driver->getConfig();
+
+    if ($config->isDatabaseReadOnly() !== true) {
+      throw new ResultCacheRequiresReadOnlyException(
+        'config='.get_class($config),
+      );
+    }
+
+    $this->_driver = $driver;
+    $this->_cache = $cache;
+    $this->_ttl = $ttl;
+    $this->_maxRows = self::DEFAULT_MAX_ROWS;
+    $this->_namespace = sha1(get_class($config));
+    $this->_hits = 0;
+    $this->_misses = 0;
+
+  }
+
+  public function getDriver(): DriverInterface {
+    return $this->_driver;
+  }
+
+  public function getTTL(): int {
+    return $this->_ttl;
+  }
+
+  public function setTTL(int $ttl): bool {
+    $this->_ttl = $ttl;
+    return true;
+  }
+
+  public function getMaxRows(): int {
+    return $this->_maxRows;
+  }
+
+  /**
+   * Results larger than this are passed through uncached.
+   */
+  public function setMaxRows(int $maxRows): bool {
+    $this->_maxRows = $maxRows;
+    return true;
+  }
+
+  public function getHitCount(): int {
+    return $this->_hits;
+  }
+
+  public function getMissCount(): int {
+    return $this->_misses;
+  }
+
+  public function query(string $sql): ResultSetInterface {
+    try {
+      return $this->queryWithTables($sql, self::extractTables($sql));
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
+  public function queryWithTables(
+    string $sql,
+    Vector<string> $tables,
+    int $ttlOverride = -1,
+  ): ResultSetInterface {
+
+    try {
+
+      if (self::isCacheable($sql) !== true) {
+        return $this->_driver->query($sql);
+      }
+
+      $key = $this->createKey($sql);
+
+      // Read before the query runs, an invalidate that lands mid query leaves
+      // the entry stale rather than wrongly fresh.
+      $versions = $this->getTableVersions($tables);
+
+      $entry = $this->_cache->directGet($key);
+
+      if (is_array($entry) &&
+          idx($entry, 'sql') === $sql &&
+          idx($entry, 'versions') == $versions) {
+        $rows = idx($entry, 'rows');
+        if (is_array($rows)) {
+          $this->_hits++;
+          return new CachedResultSet($sql, new Vector($rows));
+        }
+      }
+
+      $this->_misses++;
+
+      $resultSet = $this->_driver->query($sql);
+
+      if ($resultSet->getNumRows() > $this->_maxRows) {
+        return $resultSet;
+      }
+
+      $rows = Vector {};
+      while ($resultSet->next() === true) {
+        $rows->add($resultSet->fetchMap()->toArray());
+      }
+
+      $resultSet->freeCursor();
+
+      $ttl = ($ttlOverride > 0) ? $ttlOverride : $this->_ttl;
+
+      $this->_cache->directSet(
+        $key,
+        array(
+          'sql' => $sql,
+          'versions' => $versions,
+          'rows' => $rows->toArray(),
+        ),
+        0,
+        $ttl,
+      );
+
+      return new CachedResultSet($sql, $rows);
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Batches are passed straight through, nothing in them is cached.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<ResultSetInterface> {
+    return $this->_driver->queryBatch($statements, $atomic);
+  }
+
+  /**
+   * Expires every cached result that read from the table.
+   */
+  public function invalidateTable(string $table): bool {
+
+    $tagKey = $this->createTagKey($table);
+
+    if ($this->_cache->directIncrement($tagKey) > 0) {
+      return true;
+    }
+
+    $this->_cache->directSet($tagKey, self::createVersion());
+
+    return true;
+
+  }
+
+  public function invalidateQuery(string $sql): bool {
+    return $this->_cache->directDelete($this->createKey($sql));
+  }
+
+  public static function isCacheable(string $sql): bool {
+    if (preg_match('/^\s*(SELECT|WITH)\b/i', $sql) &&
+        !preg_match('/\bFOR\s+UPDATE\b/i', $sql)) {
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Best effort table list from FROM / JOIN clauses, lower cased with any
+   * quoting removed.
+   */
+  public static function extractTables(string $sql): Vector<string> {
+
+    $tables = Vector {};
+
+    $matches = array();
+    $identifier = '[`"]?[a-z_][a-z0-9_$]*[`"]?';
+    preg_match_all(
+      '/\b(?:FROM|JOIN)\s+('.$identifier.'(?:\.'.$identifier.')?)/i',
+      $sql,
+      $matches,
+    );
+
+    foreach ($matches[1] as $table) {
+      $table = strtolower(str_replace(array('`', '"'), '', $table));
+      if ($table !== 'dual' && $tables->linearSearch($table) == -1) {
+        $tables->add($table);
+      }
+    }
+
+    return $tables;
+
+  }
+
+  private function getTableVersions(
+    Vector<string> $tables,
+  ): array<string, int> {
+
+    $versions = array();
+
+    foreach ($tables as $table) {
+
+      $table = strtolower($table);
+      $tagKey = $this->createTagKey($table);
+
+      $version = $this->_cache->directGet($tagKey);
+
+      // Never seen or evicted, start a fresh version that no older entry
+      // could have recorded.
+      if (!is_numeric($version)) {
+        $version = self::createVersion();
+        if ($this->_cache->directAdd($tagKey, $version) !== true) {
+          $version = $this->_cache->directGet($tagKey);
+        }
+      }
+
+      $versions[$table] = intval($version);
+
+    }
+
+    ksort($versions);
+
+    return $versions;
+
+  }
+
+  private function createKey(string $sql): string {
+    return self::KEY_PREFIX.':'.$this->_namespace.':'.sha1($sql);
+  }
+
+  private function createTagKey(string $table): string {
+    return self::KEY_PREFIX.':'.$this->_namespace.':t:'.strtolower($table);
+  }
+
+  private static function createVersion(): int {
+    return (int) (microtime(true) * 1000000);
+  }
+
+  public function connect(): bool {
+    return $this->_driver->connect();
+  }
+
+  public function disconnect(): bool {
+    return $this->_driver->disconnect();
+  }
+
+  public function hadError(): bool {
+    return $this->_driver->hadError();
+  }
+
+  public function getLastError(): string {
+    return $this->_driver->getLastError();
+  }
+
+  public function quote(): QuoteInterface {
+    return $this->_driver->quote();
+  }
+
+  public function getQuoter(): QuoteInterface {
+    return $this->_driver->getQuoter();
+  }
+
+  public function nativeQuoteString(string $value): string {
+    return $this->_driver->nativeQuoteString($value);
+  }
+
+  public function transaction(): TransactionInterface {
+    return $this->_driver->transaction();
+  }
+
+  public function getTransaction(): TransactionInterface {
+    return $this->_driver->getTransaction();
+  }
+
+  public function setIsConnected(bool $state): bool {
+    return $this->_driver->setIsConnected($state);
+  }
+
+  public function getIsConnected(): bool {
+    return $this->_driver->getIsConnected();
+  }
+
+  public function isConnected(): bool {
+    return $this->_driver->isConnected();
+  }
+
+}
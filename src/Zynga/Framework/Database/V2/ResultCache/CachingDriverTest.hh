@@ -0,0 +1,126 @@
+<?hh //strict
+
+namespace Zynga\Framework\Database\V2\ResultCache;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+use Zynga\Framework\Cache\V2\Config\InMemory\Mock\Dev as InMemoryConfig;
+use Zynga\Framework\Cache\V2\Driver\InMemory as InMemoryCache;
+use Zynga\Framework\Database\V2\Config\Mock\Dev as ReadWriteConfig;
+use Zynga\Framework\Database\V2\Config\Mock\ReadOnly\Dev as ReadOnlyConfig;
+use Zynga\Framework\Database\V2\Driver\Mock as MockDriver;
+use
+  Zynga\Framework\Database\V2\Exceptions\ResultCacheRequiresReadOnlyException
+;
+use Zynga\Framework\Database\V2\Interfaces\ResultSetInterface;
+use Zynga\Framework\Database\V2\ResultCache\CachedResultSet;
+use Zynga\Framework\Database\V2\ResultCache\CachingDriver;
+
+class CachingDriverTest extends TestCase {
+
+  private function createCache(): InMemoryCache {
+    $cache = new InMemoryCache(new InMemoryConfig());
+    $cache->clearInMemoryCache();
+    return $cache;
+  }
+
+  private function getRows(ResultSetInterface $rs): Vector<mixed> {
+    $ids = Vector {};
+    while ($rs->next() === true) {
+      $ids->add($rs->fetchMap()['id']);
+    }
+    return $ids;
+  }
+
+  public function test_requiresReadOnly(): void {
+    $this->expectException(ResultCacheRequiresReadOnlyException::class);
+    new CachingDriver(
+      new MockDriver(new ReadWriteConfig()),
+      $this->createCache(),
+    );
+  }
+
+  public function test_hitAndInvalidate(): void {
+
+    $driver = new MockDriver(new ReadOnlyConfig());
+    $driver->addResultSet(Vector {Map {'id' => 1}, Map {'id' => 2}});
+    $driver->addResultSet(Vector {Map {'id' => 3}});
+
+    $cached = new CachingDriver($driver, $this->createCache());
+
+    $sql = 'SELECT id FROM items WHERE user_id = 12';
+
+    $this->assertEquals(Vector {1, 2}, $this->getRows($cached->query($sql)));
+    $this->assertEquals(0, $cached->getHitCount());
+    $this->assertEquals(1, $cached->getMissCount());
+
+    // Served from cache, the driver's second result set is untouched.
+    $rs = $cached->query($sql);
+    $this->assertTrue($rs instanceof CachedResultSet);
+    $this->assertEquals(2, $rs->getNumRows());
+    $this->assertEquals(Vector {1, 2}, $this->getRows($rs));
+    $this->assertEquals(1, $cached->getHitCount());
+
+    $this->assertTrue($cached->invalidateTable('items'));
+
+    $this->assertEquals(Vector {3}, $this->getRows($cached->query($sql)));
+    $this->assertEquals(2, $cached->getMissCount());
+
+  }
+
+  public function test_invalidateQuery(): void {
+
+    $driver = new MockDriver(new ReadOnlyConfig());
+    $driver->addResultSet(Vector {Map {'id' => 1}});
+    $driver->addResultSet(Vector {Map {'id' => 2}});
+
+    $cached = new CachingDriver($driver, $this->createCache());
+
+    $sql = 'SELECT id FROM items';
+
+    $this->assertEquals(Vector {1}, $this->getRows($cached->query($sql)));
+    $this->assertTrue($cached->invalidateQuery($sql));
+    $this->assertEquals(Vector {2}, $this->getRows($cached->query($sql)));
+
+  }
+
+  public function test_largeResultsPassThrough(): void {
+
+    $driver = new MockDriver(new ReadOnlyConfig());
+    $driver->addResultSet(Vector {Map {'id' => 1}, Map {'id' => 2}});
+
+    $cached = new CachingDriver($driver, $this->createCache());
+    $this->assertTrue($cached->setMaxRows(1));
+
+    $rs = $cached->query('SELECT id FROM items');
+    $this->assertFalse($rs instanceof CachedResultSet);
+    $this->assertEquals(Vector {1, 2}, $this->getRows($rs));
+
+  }
+
+  public function test_isCacheable(): void {
+    $this->assertTrue(CachingDriver::isCacheable('SELECT 1'));
+    $this->assertTrue(
+      CachingDriver::isCacheable(' with x as (select 1) select * from x'),
+    );
+    $this->assertFalse(
+      CachingDriver::isCacheable('SELECT * FROM t FOR UPDATE'),
+    );
+    $this->assertFalse(CachingDriver::isCacheable('UPDATE t SET a = 1'));
+  }
+
+  public function test_extractTables(): void {
+    $this->assertEquals(
+      Vector {'items', 'reporting.users'},
+      CachingDriver::extractTables(
+        'SELECT * FROM `items` i JOIN reporting.users u ON u.id = i.user_id '.
+        'WHERE i.id IN (SELECT id FROM items)',
+      ),
+    );
+    $this->assertEquals(
+      Vector {},
+      CachingDriver::extractTables('SELECT 1 FROM DUAL'),
+    );
+  }
+
+}
@@ -0,0 +1,263 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Aggregation;
+
+/**
+ * Holds metrics in memory between flushes, keyed by stat + type + tags.
+ *
+ * Counters are summed (scaled back up by their sample rate), gauges keep the
+ * last value, and histogram / timing samples are buffered as is. Sets,
+ * events and service checks are not aggregated and should go out directly.
+ *
+ * With enableSketches() histogram / timing samples go into a Sketch per key
+ * instead, and a flush emits one weighted distribution point per sketch
+ * bucket in place of every sample.
+ *
+ * The aggregator never touches the network, the driver asks shouldFlush()
+ * after each record and drains the wire lines when it is time.
+ */
+class Aggregator {
+  const int DEFAULT_MAX_CONTEXTS = 1000;
+  const float DEFAULT_FLUSH_INTERVAL = 10.0;
+
+  private int $_maxContexts;
+  private float $_flushInterval;
+  private float $_lastFlush;
+
+  private Map<string, float> $_counters;
+  private Map<string, string> $_gauges;
+  private Map<string, Vector<string>> $_samples;
+  private int $_sampleCount;
+
+  private bool $_useSketches;
+  private float $_sketchAccuracy;
+  private Map<string, Sketch> $_sketches;
+
+  public function __construct(
+    int $maxContexts = self::DEFAULT_MAX_CONTEXTS,
+    float $flushInterval = self::DEFAULT_FLUSH_INTERVAL,
+  ) {
+    $this->_maxContexts = max(1, $maxContexts);
+    $this->_flushInterval = $flushInterval;
+    $this->_lastFlush = microtime(true);
+    $this->_counters = Map {};
+    $this->_gauges = Map {};
+    $this->_samples = Map {};
+    $this->_sampleCount = 0;
+    $this->_useSketches = false;
+    $this->_sketchAccuracy = Sketch::DEFAULT_RELATIVE_ACCURACY;
+    $this->_sketches = Map {};
+  }
+
+  /**
+   * Summarizes histogram and timing samples in a Sketch per metric. A flush
+   * sends one distribution point per bucket, 'stat:value|d|@rate', the rate
+   * carrying the bucket's weight. Datadog merges the points from every
+   * process, where per process percentile gauges would overwrite each other.
+   * The stat shows up as a distribution, percentiles are picked there.
+   */
+  public function enableSketches(
+    float $relativeAccuracy = Sketch::DEFAULT_RELATIVE_ACCURACY,
+  ): bool {
+
+    $this->_sketchAccuracy = $relativeAccuracy;
+    $this->_useSketches = true;
+
+    return true;
+
+  }
+
+  public function getUseSketches(): bool {
+    return $this->_useSketches;
+  }
+
+  public function getMaxContexts(): int {
+    return $this->_maxContexts;
+  }
+
+  public function getFlushInterval(): float {
+    return $this->_flushInterval;
+  }
+
+  /**
+   * Number of distinct stat + type + tag keys held, each buffered histogram
+   * sample counts on its own so a hot histogram still forces a flush.
+   */
+  public function getContextCount(): int {
+    return $this->_counters->count() + $this->_gauges->count() +
+      $this->_sampleCount + $this->_sketches->count();
+  }
+
+  /**
+   * Takes a metric in the form send() builds it, $value being
+   * 'value|type' with an optional '|@rate'. Returns false if the type is not
+   * one we aggregate, the caller should send those straight away.
+   */
+  public function record(string $stat, string $value, string $tags): bool {
+
+    $parts = explode('|', $value);
+
+    if (count($parts) < 2) {
+      return false;
+    }
+
+    $type = $parts[1];
+    $rateSuffix = '';
+    $rate = 1.0;
+
+    if (count($parts) > 2 && substr($parts[2], 0, 1) === '@') {
+      $rateSuffix = '|'.$parts[2];
+      $rate = floatval(substr($parts[2], 1));
+    }
+
+    if ($type === 'c') {
+      $key = self::createKey($stat, 'c', $tags);
+      $delta = floatval($parts[0]);
+      if ($rate > 0.0) {
+        $delta = $delta / $rate;
+      }
+      $sum = $this->_counters->get($key);
+      if ($sum === null) {
+        $sum = 0.0;
+      }
+      $this->_counters->set($key, $sum + $delta);
+      return true;
+    }
+
+    if ($type === 'g') {
+      $this->_gauges->set(self::createKey($stat, 'g', $tags), $parts[0]);
+      return true;
+    }
+
+    if ($type === 'h' || $type === 'ms' || $type === 'd') {
+
+      if ($this->_useSketches === true) {
+        $key = self::createKey($stat, $type, $tags);
+        $sketch = $this->_sketches->get($key);
+        if ($sketch === null) {
+          $sketch = new Sketch($this->_sketchAccuracy);
+          $this->_sketches->set($key, $sketch);
+        }
+        $sketch->add(floatval($parts[0]), ($rate > 0.0) ? 1 / $rate : 1.0);
+        return true;
+      }
+
+      $key = self::createKey($stat, $type.$rateSuffix, $tags);
+      $samples = $this->_samples->get($key);
+      if ($samples === null) {
+        $samples = Vector {};
+        $this->_samples->set($key, $samples);
+      }
+      $samples->add($parts[0]);
+      $this->_sampleCount++;
+      return true;
+    }
+
+    return false;
+
+  }
+
+  public function shouldFlush(): bool {
+
+    if ($this->getContextCount() >= $this->_maxContexts) {
+      return true;
+    }
+
+    if ($this->getContextCount() > 0 &&
+        (microtime(true) - $this->_lastFlush) >= $this->_flushInterval) {
+      return true;
+    }
+
+    return false;
+
+  }
+
+  /**
+   * Returns everything held as 'stat:value|type[|@rate][|tags]' lines and
+   * starts over empty.
+   */
+  public function drain(): Vector<string> {
+
+    $lines = Vector {};
+
+    foreach ($this->_counters as $key => $sum) {
+      $lines->add(self::createLine($key, strval($sum)));
+    }
+
+    foreach ($this->_gauges as $key => $value) {
+      $lines->add(self::createLine($key, $value));
+    }
+
+    foreach ($this->_samples as $key => $samples) {
+      foreach ($samples as $value) {
+        $lines->add(self::createLine($key, $value));
+      }
+    }
+
+    foreach ($this->_sketches as $key => $sketch) {
+      $this->addSketchLines($lines, $key, $sketch);
+    }
+
+    $this->_counters = Map {};
+    $this->_gauges = Map {};
+    $this->_samples = Map {};
+    $this->_sampleCount = 0;
+    $this->_sketches = Map {};
+    $this->_lastFlush = microtime(true);
+
+    return $lines;
+
+  }
+
+  private function addSketchLines(
+    Vector<string> $lines,
+    string $key,
+    Sketch $sketch,
+  ): void {
+
+    list($stat, $type, $tags) = explode("\n", $key, 3);
+
+    foreach ($sketch->getWeightedValues() as $point) {
+
+      list($value, $weight) = $point;
+
+      $pointType = 'd';
+
+      if ($weight > 1.0) {
+        $pointType .= '|@'.strval(1 / $weight);
+      }
+
+      $lines->add(
+        self::createLine(
+          $stat."\n".$pointType."\n".$tags,
+          strval($value),
+        ),
+      );
+
+    }
+
+  }
+
+  private static function createKey(
+    string $stat,
+    string $type,
+    string $tags,
+  ): string {
+    return $stat."\n".$type."\n".$tags;
+  }
+
+  private static function createLine(string $key, string $value): string {
+
+    list($stat, $type, $tags) = explode("\n", $key, 3);
+
+    $line = $stat.':'.$value.'|'.$type;
+
+    if ($tags !== '') {
+      $line .= '|'.$tags;
+    }
+
+    return $line;
+
+  }
+
+}
@@ -0,0 +1,154 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2\Aggregation;
+
+use Zynga\Framework\Datadog\V2\Aggregation\Aggregator;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class AggregatorTest extends TestCase {
+
+  public function testCountersAreSummed(): void {
+
+    $agg = new Aggregator();
+
+    for ($i = 0; $i < 50; $i++) {
+      $this->assertTrue($agg->record('hits', '1|c', ''));
+    }
+    $this->assertTrue($agg->record('hits', '-5|c', ''));
+
+    $this->assertEquals(1, $agg->getContextCount());
+    $this->assertEquals(Vector {'hits:45|c'}, $agg->drain());
+    $this->assertEquals(0, $agg->getContextCount());
+
+  }
+
+  public function testCountersScaleBySampleRate(): void {
+    $agg = new Aggregator();
+    $agg->record('hits', '1|c|@0.5', '');
+    $agg->record('hits', '1|c|@0.5', '');
+    $this->assertEquals(Vector {'hits:4|c'}, $agg->drain());
+  }
+
+  public function testTagsAreSeparateContexts(): void {
+
+    $agg = new Aggregator();
+    $agg->record('hits', '1|c', '#a:1');
+    $agg->record('hits', '1|c', '#a:2');
+    $agg->record('hits', '1|c', '#a:1');
+
+    $this->assertEquals(2, $agg->getContextCount());
+    $this->assertEquals(
+      Vector {'hits:2|c|#a:1', 'hits:1|c|#a:2'},
+      $agg->drain(),
+    );
+
+  }
+
+  public function testGaugesKeepLastValue(): void {
+    $agg = new Aggregator();
+    $agg->record('depth', '3|g', '');
+    $agg->record('depth', '7|g', '');
+    $this->assertEquals(Vector {'depth:7|g'}, $agg->drain());
+  }
+
+  public function testSamplesAreBuffered(): void {
+
+    $agg = new Aggregator();
+    $agg->record('latency', '1.5|ms', '');
+    $agg->record('latency', '2.5|ms', '');
+    $agg->record('size', '10|h|@0.1', '#a:b');
+
+    $this->assertEquals(3, $agg->getContextCount());
+    $this->assertEquals(
+      Vector {'latency:1.5|ms', 'latency:2.5|ms', 'size:10|h|@0.1|#a:b'},
+      $agg->drain(),
+    );
+
+  }
+
+  public function testUnaggregatedTypes(): void {
+    $agg = new Aggregator();
+    $this->assertFalse($agg->record('users', '1|s', ''));
+    $this->assertFalse($agg->record('bad', 'nope', ''));
+    $this->assertEquals(0, $agg->getContextCount());
+  }
+
+  public function testShouldFlushOnContextCount(): void {
+
+    $agg = new Aggregator(2, 3600.0);
+    $this->assertEquals(2, $agg->getMaxContexts());
+
+    $agg->record('a', '1|c', '');
+    $this->assertFalse($agg->shouldFlush());
+
+    $agg->record('b', '1|c', '');
+    $this->assertTrue($agg->shouldFlush());
+
+    $agg->drain();
+    $this->assertFalse($agg->shouldFlush());
+
+  }
+
+  public function testShouldFlushOnInterval(): void {
+
+    $agg = new Aggregator(1000, 0.0);
+    $this->assertFalse($agg->shouldFlush());
+
+    $agg->record('a', '1|c', '');
+    $this->assertTrue($agg->shouldFlush());
+
+  }
+
+  public function testSketches(): void {
+
+    $agg = new Aggregator();
+    $this->assertFalse($agg->getUseSketches());
+
+    $this->assertTrue($agg->enableSketches());
+    $this->assertTrue($agg->getUseSketches());
+
+    for ($i = 1; $i <= 100; $i++) {
+      $agg->record('latency', $i.'|ms', '#a:b');
+    }
+
+    // One sketch, however many samples.
+    $this->assertEquals(1, $agg->getContextCount());
+
+    $lines = $agg->drain();
+
+    // Distribution points the agent can merge across processes, their
+    // weights add back up to the samples taken.
+    $this->assertTrue($lines->count() <= 100);
+
+    $weight = 0.0;
+
+    foreach ($lines as $line) {
+      $matches = array();
+      $this->assertEquals(
+        1,
+        preg_match(
+          '/^latency:[0-9.]+\|d(\|@([0-9.E-]+))?\|#a:b$/',
+          $line,
+          $matches,
+        ),
+      );
+      $weight += count($matches) > 2 ? 1 / floatval($matches[2]) : 1.0;
+    }
+
+    $this->assertEquals(100.0, $weight, '', 0.01);
+    $this->assertEquals('latency:1|d|#a:b', $lines[0]);
+
+  }
+
+  public function testSketchesScaleBySampleRate(): void {
+
+    $agg = new Aggregator();
+    $agg->enableSketches();
+
+    $agg->record('size', '10|h|@0.5', '');
+
+    $this->assertEquals('size:10|d|@0.5', $agg->drain()[0]);
+
+  }
+
+}
@@ -0,0 +1,307 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Aggregation;
+
+/**
+ * DDSketch style quantile sketch. Values land in logarithmically sized
+ * buckets, so any quantile read back is within relativeAccuracy of the true
+ * value no matter how many samples went in, and two sketches merge by
+ * adding bucket counts.
+ *
+ * Memory is bounded by maxBuckets, past that the buckets closest to zero
+ * are folded together, which only costs accuracy for the smallest
+ * magnitudes.
+ */
+class Sketch {
+  const float DEFAULT_RELATIVE_ACCURACY = 0.01;
+  const int DEFAULT_MAX_BUCKETS = 2048;
+
+  // Anything closer to zero than this is counted as zero.
+  const float MIN_INDEXABLE_VALUE = 1.0e-9;
+
+  private float $_relativeAccuracy;
+  private float $_gamma;
+  private float $_logGamma;
+  private int $_maxBuckets;
+
+  private Map<int, float> $_positive;
+  private Map<int, float> $_negative;
+  private float $_zeroCount;
+
+  private float $_count;
+  private float $_sum;
+  private float $_min;
+  private float $_max;
+
+  public function __construct(
+    float $relativeAccuracy = self::DEFAULT_RELATIVE_ACCURACY,
+    int $maxBuckets = self::DEFAULT_MAX_BUCKETS,
+  ) {
+
+    $relativeAccuracy = min(max($relativeAccuracy, 0.0001), 0.5);
+
+    $this->_relativeAccuracy = $relativeAccuracy;
+    $this->_gamma = (1 + $relativeAccuracy) / (1 - $relativeAccuracy);
+    $this->_logGamma = log($this->_gamma);
+    $this->_maxBuckets = max(2, $maxBuckets);
+
+    $this->_positive = Map {};
+    $this->_negative = Map {};
+    $this->_zeroCount = 0.0;
+
+    $this->_count = 0.0;
+    $this->_sum = 0.0;
+    $this->_min = INF;
+    $this->_max = -INF;
+
+  }
+
+  public function getRelativeAccuracy(): float {
+    return $this->_relativeAccuracy;
+  }
+
+  /**
+   * Adds a sample. $weight is how many samples it stands for, 1 / rate for
+   * a sampled metric.
+   */
+  public function add(float $value, float $weight = 1.0): bool {
+
+    if ($weight <= 0.0 || is_nan($value) || is_infinite($value)) {
+      return false;
+    }
+
+    if ($value > self::MIN_INDEXABLE_VALUE) {
+      self::addToBucket($this->_positive, $this->getIndex($value), $weight);
+      $this->collapse($this->_positive);
+    } else if ($value < -self::MIN_INDEXABLE_VALUE) {
+      self::addToBucket($this->_negative, $this->getIndex(-$value), $weight);
+      $this->collapse($this->_negative);
+    } else {
+      $this->_zeroCount += $weight;
+    }
+
+    $this->_count += $weight;
+    $this->_sum += $value * $weight;
+
+    if ($value < $this->_min) {
+      $this->_min = $value;
+    }
+
+    if ($value > $this->_max) {
+      $this->_max = $value;
+    }
+
+    return true;
+
+  }
+
+  /**
+   * Folds another sketch of the same accuracy into this one.
+   */
+  public function merge(Sketch $other): bool {
+
+    if ($other->getRelativeAccuracy() != $this->_relativeAccuracy) {
+      return false;
+    }
+
+    if ($other->getCount() == 0.0) {
+      return true;
+    }
+
+    foreach ($other->getPositiveBuckets() as $index => $count) {
+      self::addToBucket($this->_positive, $index, $count);
+    }
+
+    foreach ($other->getNegativeBuckets() as $index => $count) {
+      self::addToBucket($this->_negative, $index, $count);
+    }
+
+    $this->collapse($this->_positive);
+    $this->collapse($this->_negative);
+
+    $this->_zeroCount += $other->getZeroCount();
+    $this->_count += $other->getCount();
+    $this->_sum += $other->getSum();
+    $this->_min = min($this->_min, $other->getMin());
+    $this->_max = max($this->_max, $other->getMax());
+
+    return true;
+
+  }
+
+  public function getCount(): float {
+    return $this->_count;
+  }
+
+  public function getSum(): float {
+    return $this->_sum;
+  }
+
+  public function getMin(): float {
+    return $this->_count > 0.0 ? $this->_min : 0.0;
+  }
+
+  public function getMax(): float {
+    return $this->_count > 0.0 ? $this->_max : 0.0;
+  }
+
+  public function getAverage(): float {
+    return $this->_count > 0.0 ? $this->_sum / $this->_count : 0.0;
+  }
+
+  public function getZeroCount(): float {
+    return $this->_zeroCount;
+  }
+
+  public function getPositiveBuckets(): Map<int, float> {
+    return $this->_positive;
+  }
+
+  public function getNegativeBuckets(): Map<int, float> {
+    return $this->_negative;
+  }
+
+  public function getBucketCount(): int {
+    return $this->_positive->count() + $this->_negative->count();
+  }
+
+  /**
+   * One (value, weight) pair per non empty bucket, lowest value first. The
+   * value stands for every sample in its bucket within relativeAccuracy,
+   * which is what lets the sketch be shipped as weighted points.
+   */
+  public function getWeightedValues(): Vector<Pair<float, float>> {
+
+    $values = Vector {};
+
+    $negative = $this->_negative->keys()->toArray();
+    rsort($negative);
+
+    foreach ($negative as $index) {
+      $values->add(
+        Pair {
+          $this->clamp(-$this->getValue($index)),
+          $this->_negative[$index],
+        },
+      );
+    }
+
+    if ($this->_zeroCount > 0.0) {
+      $values->add(Pair {$this->clamp(0.0), $this->_zeroCount});
+    }
+
+    $positive = $this->_positive->keys()->toArray();
+    sort($positive);
+
+    foreach ($positive as $index) {
+      $values->add(
+        Pair {$this->clamp($this->getValue($index)), $this->_positive[$index]},
+      );
+    }
+
+    return $values;
+
+  }
+
+  /**
+   * Value at quantile $q (0 - 1), within relativeAccuracy of the true one.
+   */
+  public function getQuantile(float $q): float {
+
+    if ($this->_count <= 0.0) {
+      return 0.0;
+    }
+
+    if ($q <= 0.0) {
+      return $this->_min;
+    }
+
+    if ($q >= 1.0) {
+      return $this->_max;
+    }
+
+    $rank = $q * ($this->_count - 1);
+    $seen = 0.0;
+
+    // Most negative first, that is the largest index on the negative side.
+    $negative = $this->_negative->keys()->toArray();
+    rsort($negative);
+
+    foreach ($negative as $index) {
+      $seen += $this->_negative[$index];
+      if ($seen > $rank) {
+        return $this->clamp(-$this->getValue($index));
+      }
+    }
+
+    $seen += $this->_zeroCount;
+    if ($seen > $rank) {
+      return $this->clamp(0.0);
+    }
+
+    $positive = $this->_positive->keys()->toArray();
+    sort($positive);
+
+    foreach ($positive as $index) {
+      $seen += $this->_positive[$index];
+      if ($seen > $rank) {
+        return $this->clamp($this->getValue($index));
+      }
+    }
+
+    return $this->_max;
+
+  }
+
+  private function getIndex(float $value): int {
+    return (int) ceil(log($value) / $this->_logGamma);
+  }
+
+  /**
+   * The point in the bucket that is within relativeAccuracy of every value
+   * that maps to it.
+   */
+  private function getValue(int $index): float {
+    return 2 * pow($this->_gamma, $index) / ($this->_gamma + 1);
+  }
+
+  private function clamp(float $value): float {
+    return min(max($value, $this->_min), $this->_max);
+  }
+
+  private static function addToBucket(
+    Map<int, float> $buckets,
+    int $index,
+    float $count,
+  ): void {
+    $current = $buckets->get($index);
+    $buckets->set($index, ($current === null) ? $count : $current + $count);
+  }
+
+  /**
+   * Folds the buckets closest to zero into their neighbour until under the
+   * cap.
+   */
+  private function collapse(Map<int, float> $buckets): void {
+
+    if ($buckets->count() <= $this->_maxBuckets) {
+      return;
+    }
+
+    $indexes = $buckets->keys()->toArray();
+    sort($indexes);
+
+    $excess = $buckets->count() - $this->_maxBuckets;
+    $target = $indexes[$excess];
+    $folded = 0.0;
+
+    for ($i = 0; $i < $excess; $i++) {
+      $folded += $buckets[$indexes[$i]];
+      $buckets->remove($indexes[$i]);
+    }
+
+    $buckets->set($target, $buckets[$target] + $folded);
+
+  }
+
+}
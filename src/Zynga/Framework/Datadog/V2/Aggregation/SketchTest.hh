@@ -0,0 +1,148 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2\Aggregation;
+
+use Zynga\Framework\Datadog\V2\Aggregation\Sketch;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class SketchTest extends TestCase {
+
+  const int SAMPLE_COUNT = 10000;
+
+  private function assertWithinAccuracy(
+    Sketch $sketch,
+    array<float> $sorted,
+  ): void {
+
+    $accuracy = $sketch->getRelativeAccuracy();
+
+    foreach (array(0.01, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999) as $q) {
+
+      $exact = $sorted[(int) floor($q * (count($sorted) - 1))];
+      $estimate = $sketch->getQuantile($q);
+
+      $error = abs($estimate - $exact) / abs($exact);
+
+      $this->assertLessThanOrEqual(
+        $accuracy + 0.000001,
+        $error,
+        'q='.$q.' exact='.$exact.' estimate='.$estimate,
+      );
+
+    }
+
+  }
+
+  public function testUniformAccuracyAndSize(): void {
+
+    $sketch = new Sketch();
+    $sorted = array();
+
+    for ($i = 1; $i <= self::SAMPLE_COUNT; $i++) {
+      $sketch->add(floatval($i));
+      $sorted[] = floatval($i);
+    }
+
+    $this->assertWithinAccuracy($sketch, $sorted);
+
+    // log(10000) / log(1.0202), a few hundred buckets for 10k samples.
+    $this->assertLessThan(500, $sketch->getBucketCount());
+
+  }
+
+  public function testLongTailAccuracy(): void {
+
+    $sketch = new Sketch(0.02);
+    $sorted = array();
+
+    for ($i = 0; $i < self::SAMPLE_COUNT; $i++) {
+      $value = exp(($i % 1000) / 100.0);
+      $sketch->add($value);
+      $sorted[] = $value;
+    }
+
+    sort($sorted);
+
+    $this->assertWithinAccuracy($sketch, $sorted);
+
+  }
+
+  public function testSummary(): void {
+
+    $sketch = new Sketch();
+    $this->assertEquals(0.0, $sketch->getQuantile(0.5));
+    $this->assertEquals(0.0, $sketch->getMin());
+    $this->assertEquals(0.0, $sketch->getAverage());
+
+    $this->assertTrue($sketch->add(2.0));
+    $this->assertTrue($sketch->add(4.0, 3.0));
+    $this->assertFalse($sketch->add(1.0, 0.0));
+    $this->assertFalse($sketch->add(NAN));
+
+    $this->assertEquals(4.0, $sketch->getCount());
+    $this->assertEquals(14.0, $sketch->getSum());
+    $this->assertEquals(3.5, $sketch->getAverage());
+    $this->assertEquals(2.0, $sketch->getMin());
+    $this->assertEquals(4.0, $sketch->getMax());
+    $this->assertEquals(2.0, $sketch->getQuantile(0.0));
+    $this->assertEquals(4.0, $sketch->getQuantile(1.0));
+
+  }
+
+  public function testNegativeAndZero(): void {
+
+    $sketch = new Sketch();
+    $sketch->add(-100.0);
+    $sketch->add(0.0);
+    $sketch->add(100.0);
+
+    $this->assertEquals(1.0, $sketch->getZeroCount());
+    $this->assertEquals(2, $sketch->getBucketCount());
+    $this->assertEquals(-100.0, $sketch->getQuantile(0.0));
+    $this->assertEquals(0.0, $sketch->getQuantile(0.5));
+    $this->assertEquals(100.0, $sketch->getQuantile(1.0));
+
+  }
+
+  public function testMerge(): void {
+
+    $first = new Sketch();
+    $second = new Sketch();
+    $sorted = array();
+
+    for ($i = 1; $i <= self::SAMPLE_COUNT; $i++) {
+      ($i % 2 == 0) ? $first->add(floatval($i)) : $second->add(floatval($i));
+      $sorted[] = floatval($i);
+    }
+
+    $this->assertTrue($first->merge($second));
+    $this->assertEquals(floatval(self::SAMPLE_COUNT), $first->getCount());
+    $this->assertEquals(1.0, $first->getMin());
+
+    $this->assertWithinAccuracy($first, $sorted);
+
+    $this->assertFalse($first->merge(new Sketch(0.05)));
+
+  }
+
+  public function testMaxBuckets(): void {
+
+    $sketch = new Sketch(0.01, 50);
+
+    for ($i = 1; $i <= self::SAMPLE_COUNT; $i++) {
+      $sketch->add(floatval($i));
+    }
+
+    $this->assertEquals(50, $sketch->getBucketCount());
+    $this->assertEquals(floatval(self::SAMPLE_COUNT), $sketch->getCount());
+
+    // Only the low end is folded, the top stays accurate.
+    $exact = 9900.0;
+    $this->assertLessThanOrEqual(
+      0.010001,
+      abs($sketch->getQuantile(0.99) - $exact) / $exact,
+    );
+
+  }
+
+}
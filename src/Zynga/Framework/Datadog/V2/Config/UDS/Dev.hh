@@ -0,0 +1,25 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Config\UDS;
+
+use Zynga\Framework\Datadog\V2\Interfaces\UDSDriverConfigInterface;
+
+class Dev implements UDSDriverConfigInterface {
+
+  public function getServerHostname(): string {
+    return 'localhost';
+  }
+
+  public function getServerPort(): int {
+    return 8125;
+  }
+
+  public function getSocketPath(): string {
+    return '/var/run/datadog/dsd.socket';
+  }
+
+  public function getDriver(): string {
+    return 'UDS';
+  }
+
+}
@@ -5,6 +5,7 @@ namespace Zynga\Framework\Datadog\V2\Driver;
 use Zynga\Framework\Datadog\V2\Exceptions\MockQueriesRequired;
 use Zynga\Framework\Datadog\V2\Interfaces\DriverConfigInterface;
 use Zynga\Framework\Datadog\V2\Interfaces\DriverInterface;
+use Zynga\Framework\Datadog\V2\TagSet;
 
 /**
  * Base implementation of the Datadog driver
@@ -21,12 +22,41 @@ abstract class Base implements DriverInterface {
    **/
   private bool $_requireMockQueries;
 
+  /**
+   * Tags added to every metric this driver sends
+   **/
+  private TagSet $_defaultTags;
+
   /**
    * Inherited from DriverInterface
    **/
   public function __construct(DriverConfigInterface $config) {
     $this->_config = $config;
     $this->_requireMockQueries = false;
+    $this->_defaultTags = TagSet::none();
+  }
+
+  /**
+   * Inherited from DriverInterface
+   **/
+  public function getDefaultTags(): TagSet {
+    return $this->_defaultTags;
+  }
+
+  /**
+   * Inherited from DriverInterface
+   **/
+  public function setDefaultTags(KeyedTraversable<string, string> $tags): bool {
+    $this->_defaultTags = TagSet::intern($tags);
+    return true;
+  }
+
+  /**
+   * Wire form of the default tags followed by the call's tags, '' if there
+   * are neither.
+   **/
+  public function renderTags(?KeyedTraversable<string, string> $tags): string {
+    return TagSet::concatWire($this->_defaultTags->toWire(), TagSet::render($tags));
   }
 
   /**
@@ -15,7 +15,7 @@ class Mock extends DriverBase {
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -27,7 +27,7 @@ class Mock extends DriverBase {
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -39,7 +39,7 @@ class Mock extends DriverBase {
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -51,7 +51,7 @@ class Mock extends DriverBase {
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -62,7 +62,7 @@ class Mock extends DriverBase {
   public function histogramStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -74,7 +74,7 @@ class Mock extends DriverBase {
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -92,7 +92,7 @@ class Mock extends DriverBase {
   public function setStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -103,7 +103,7 @@ class Mock extends DriverBase {
   public function increment(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -114,7 +114,7 @@ class Mock extends DriverBase {
   public function incrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -125,7 +125,7 @@ class Mock extends DriverBase {
   public function decrement(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -136,7 +136,7 @@ class Mock extends DriverBase {
   public function decrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return true;
   }
@@ -147,7 +147,7 @@ class Mock extends DriverBase {
   public function serviceCheck(
     string $name,
     int $status,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
     ?string $hostname = null,
     ?string $message = null,
     ?int $timestamp = null,
@@ -2,30 +2,249 @@
 
 namespace Zynga\Framework\Datadog\V2\Driver;
 
+use Zynga\Framework\Datadog\V2\Aggregation\Aggregator;
+use Zynga\Framework\Datadog\V2\Aggregation\Sketch;
 use Zynga\Framework\Datadog\V2\Driver\Base as DriverBase;
 use Zynga\Framework\Datadog\V2\ServiceStatus;
 
 class UDP extends DriverBase {
 
+  // Keeps a datagram inside a 1500 byte ethernet MTU once the IP and UDP
+  // headers are added.
+  const int DEFAULT_MAX_PAYLOAD_BYTES = 1432;
+
+  // Deferred mode sends inline past this many queued datagrams, a long
+  // running script should not hold its metrics forever.
+  const int MAX_DEFERRED_PACKETS = 1000;
+
+  // A datagram that is not full yet waits at most this long for more lines,
+  // the first send() past it puts it on the wire.
+  const float DEFAULT_MAX_PACKET_AGE_SECONDS = 0.1;
+
   private ?resource $_socket;
+  private ?string $_serverHostname;
+  private ?int $_serverPort;
+  private ?Aggregator $_aggregator;
+  private bool $_isShutdownRegistered = false;
+
+  private string $_packet = '';
+  private int $_maxPayloadBytes = self::DEFAULT_MAX_PAYLOAD_BYTES;
+  private float $_maxPacketAgeSeconds = self::DEFAULT_MAX_PACKET_AGE_SECONDS;
+  private float $_packetStartedAt = 0.0;
+  private int $_packetsSent = 0;
+  private int $_bytesSent = 0;
+  private int $_packetsDropped = 0;
+
+  private bool $_isDeferred = false;
+  private bool $_isDraining = false;
+  private Vector<string> $_deferredPackets = Vector {};
 
   public function __destruct(): void {
+    $this->flushDeferred();
     $this->closeSocket();
   }
 
+  public function getMaxPayloadBytes(): int {
+    return $this->_maxPayloadBytes;
+  }
+
+  /**
+   * Metric lines are joined with newlines into datagrams of at most this
+   * many bytes. A single line that is longer still goes out on its own.
+   */
+  public function setMaxPayloadBytes(int $maxPayloadBytes): bool {
+    $this->flushPacket();
+    $this->_maxPayloadBytes = max(1, $maxPayloadBytes);
+    return true;
+  }
+
+  public function getMaxPacketAgeSeconds(): float {
+    return $this->_maxPacketAgeSeconds;
+  }
+
+  /**
+   * How long lines from separate calls keep packing into one datagram. 0
+   * sends the datagram at the end of every call.
+   */
+  public function setMaxPacketAgeSeconds(float $maxPacketAgeSeconds): bool {
+    $this->_maxPacketAgeSeconds = max(0.0, $maxPacketAgeSeconds);
+    return true;
+  }
+
+  public function getPacketsSent(): int {
+    return $this->_packetsSent;
+  }
+
+  public function getBytesSent(): int {
+    return $this->_bytesSent;
+  }
+
+  /**
+   * Datagrams the socket refused or only partially took.
+   */
+  public function getPacketsDropped(): int {
+    return $this->_packetsDropped;
+  }
+
+  /**
+   * Holds counters, gauges and histogram samples in memory and sends them
+   * in bulk once $maxContexts keys are held, $flushInterval seconds have
+   * passed, or the request shuts down.
+   */
+  public function enableAggregation(
+    int $maxContexts = Aggregator::DEFAULT_MAX_CONTEXTS,
+    float $flushInterval = Aggregator::DEFAULT_FLUSH_INTERVAL,
+  ): bool {
+
+    $this->flushAggregates();
+
+    $this->_aggregator = new Aggregator($maxContexts, $flushInterval);
+
+    $this->registerShutdownFlush();
+
+    return true;
+
+  }
+
+  /**
+   * Turns on aggregation if needed and summarizes histogram / timing
+   * samples in a quantile sketch per metric, sent as distribution points,
+   * see Aggregator::enableSketches.
+   */
+  public function enableHistogramSketches(
+    float $relativeAccuracy = Sketch::DEFAULT_RELATIVE_ACCURACY,
+  ): bool {
+
+    $aggregator = $this->_aggregator;
+
+    if ($aggregator === null) {
+      $this->enableAggregation();
+      $aggregator = $this->_aggregator;
+    }
+
+    if ($aggregator === null) {
+      return false;
+    }
+
+    return $aggregator->enableSketches($relativeAccuracy);
+
+  }
+
+  public function disableAggregation(): bool {
+    $this->flushAggregates();
+    $this->_aggregator = null;
+    return true;
+  }
+
+  public function getAggregator(): ?Aggregator {
+    return $this->_aggregator;
+  }
+
+  /**
+   * Sends whatever the aggregator is holding.
+   */
+  public function flushAggregates(): bool {
+
+    $aggregator = $this->_aggregator;
+
+    if ($aggregator === null || $aggregator->getContextCount() == 0) {
+      return false;
+    }
+
+    foreach ($aggregator->drain() as $line) {
+      $this->reportMetric($line);
+    }
+
+    $this->flushPacket();
+
+    return true;
+
+  }
+
+  /**
+   * Queues every datagram in memory and sends them from a shutdown
+   * function, after fastcgi_finish_request() has handed the response back
+   * to the client where it is available. Metrics then cost the request
+   * nothing but the string building.
+   */
+  public function enableDeferredFlush(): bool {
+    $this->_isDeferred = true;
+    $this->registerShutdownFlush();
+    return true;
+  }
+
+  public function disableDeferredFlush(): bool {
+    $this->flushDeferred();
+    $this->_isDeferred = false;
+    return true;
+  }
+
+  public function getIsDeferred(): bool {
+    return $this->_isDeferred;
+  }
+
+  public function getDeferredPacketCount(): int {
+    return $this->_deferredPackets->count();
+  }
+
+  /**
+   * Sends everything held back, aggregates, the pending datagram and the
+   * deferred queue.
+   */
+  public function flushDeferred(): bool {
+
+    $this->_isDraining = true;
+
+    // Oldest first, the queue, then the datagram still being packed.
+    $packets = $this->_deferredPackets;
+    $this->_deferredPackets = Vector {};
+
+    foreach ($packets as $packet) {
+      $this->flush($packet);
+    }
+
+    $this->flushPacket();
+    $this->flushAggregates();
+
+    $this->_isDraining = false;
+
+    return $packets->count() > 0;
+
+  }
+
+  private function registerShutdownFlush(): void {
+
+    if ($this->_isShutdownRegistered === true) {
+      return;
+    }
+
+    $this->_isShutdownRegistered = true;
+
+    register_shutdown_function(
+      () ==> {
+        if ($this->_isDeferred === true &&
+            function_exists('fastcgi_finish_request')) {
+          fastcgi_finish_request();
+        }
+        $this->flushDeferred();
+      },
+    );
+
+  }
+
   /**
    * Log timing information
    *
    * @param string $stat The metric to in log timing info for.
    * @param float $time The elapsed time in seconds to log
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param ?Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function timing(
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return $this->microTiming($stat, $time * 1000, $sampleRate, $tags);
   }
@@ -36,13 +255,13 @@ class UDP extends DriverBase {
    * @param string $stat The metric name
    * @param float $time The elapsed time in microseconds to log
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param array|string $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function microTiming(
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     $data[$stat] = "$time|ms";
@@ -55,13 +274,13 @@ class UDP extends DriverBase {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param array|string $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function gauge(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     $data[$stat] = "$value|g";
@@ -73,13 +292,13 @@ class UDP extends DriverBase {
    *
    * @param string $stat The metric to increment.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function increment(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return $this->updateStat($stat, 1, $sampleRate, $tags);
   }
@@ -89,13 +308,13 @@ class UDP extends DriverBase {
    *
    * @param Vector<string> $stats The metrics to increment.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function incrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return $this->updateStats($stats, 1, $sampleRate, $tags);
   }
@@ -105,13 +324,13 @@ class UDP extends DriverBase {
    *
    * @param string $stat The metric to decrement.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function decrement(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return $this->updateStat($stat, -1, $sampleRate, $tags);
   }
@@ -121,13 +340,13 @@ class UDP extends DriverBase {
    *
    * @param Vector<string> $stats The metrics to decrements.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function decrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     return $this->updateStats($stats, -1, $sampleRate, $tags);
   }
@@ -138,14 +357,14 @@ class UDP extends DriverBase {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function histogram(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     $data[$stat] = "$value|h";
@@ -157,13 +376,13 @@ class UDP extends DriverBase {
    *
    * @param Map<string,float> $stats The metrics you would like to update
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function histogramStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     foreach ($stats as $stat => $value) {
@@ -178,25 +397,36 @@ class UDP extends DriverBase {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function set(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     $data[$stat] = "$value|s";
     return $this->send($data, $sampleRate, $tags);
   }
 
+  /**
+   * Events go out as their own datagram, like service checks, and are never
+   * packed with metric lines or held back for the packet age.
+   */
   public function event(string $title, string $text): bool {
-    $data = Map {};
-    $stat = '_e{'.strlen($title).','.strlen($text).'}';
-    $data[$stat] = "$title|$text";
-    return $this->send($data, 1.0, null);
+
+    $msg = '_e{'.strlen($title).','.strlen($text).'}:'."$title|$text";
+
+    $tagString = $this->renderTags(null);
+
+    if ($tagString !== '') {
+      $msg .= '|'.$tagString;
+    }
+
+    return $this->report($msg);
+
   }
 
   /**
@@ -205,13 +435,13 @@ class UDP extends DriverBase {
    * @param Map<string, float> $stats The metrics you would like to update
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function setStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     foreach ($stats as $stat => $value) {
@@ -226,14 +456,14 @@ class UDP extends DriverBase {
    * @param string $stats The metric(s) to update. Should be either a string or array of metrics.
    * @param int $delta The amount to increment/decrement each metric by.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string   *
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function updateStat(
     string $stat,
     int $delta = 1,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     $data[$stat] = $delta.'|c';
@@ -246,14 +476,14 @@ class UDP extends DriverBase {
    * @param string $stats The metric(s) to update. Should be either a string or array of metrics.
    * @param int $delta The amount to increment/decrement each metric by.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string   *
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function updateStats(
     Vector<string> $stats,
     int $delta = 1,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool {
     $data = Map {};
     foreach ($stats as $stat) {
@@ -266,7 +496,7 @@ class UDP extends DriverBase {
    * Send a custom service check status.
    * @param string $name service check name
    * @param int $status service check status code (see static::OK, static::WARNING,...)
-   * @param ?Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @param ?string $hostname hostname to associate with this service check status
    * @param ?string $message message to associate with this service check status
    * @param ?int $timestamp timestamp for the service check status (defaults to now)
@@ -275,7 +505,7 @@ class UDP extends DriverBase {
   public function serviceCheck(
     string $name,
     int $status,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
     ?string $hostname = null,
     ?string $message = null,
     ?int $timestamp = null,
@@ -295,17 +525,10 @@ class UDP extends DriverBase {
       $msg .= sprintf("|h:%s", $hostname);
     }
 
-    if ($tags !== null && $tags->count() > 0) {
-      $tagString = '';
-      $isFirst = true;
-      foreach ($tags as $key => $value) {
-        if ($isFirst !== true) {
-          $tagString .= ',';
-        }
-        $tagString .= $key.','.$value;
-        $isFirst = false;
-      }
-      $msg .= sprintf('|#%s', $tagString);
+    $tagString = $this->renderTags($tags);
+
+    if ($tagString !== '') {
+      $msg .= '|'.$tagString;
     }
     if ($message !== null) {
       $msg .= sprintf(
@@ -320,13 +543,13 @@ class UDP extends DriverBase {
    * Squirt the metrics over UDP
    * @param array $data Incoming Data
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function send(
     Map<string, string> $data,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
     bool $forceSample = false,
   ): bool {
 
@@ -347,18 +570,18 @@ class UDP extends DriverBase {
       return false;
     }
 
-    $tagString = '';
+    // default tags plus the call's, a TagSet comes pre-rendered.
+    $tagString = $this->renderTags($tags);
 
-    if ($tags !== null && $tags->count() > 0) {
-      // append the tag values to the wire protocol.
-      foreach ($tags as $tag_key => $tag_val) {
-        $tagString .= '#'.$tag_key.':'.$tag_val.',';
-      }
-
-      $tagString = substr($tagString, 0, -1);
-    }
+    $aggregator = $this->_aggregator;
 
     foreach ($sampledData as $stat => $value) {
+
+      if ($aggregator !== null &&
+          $aggregator->record($stat, $value, $tagString) === true) {
+        continue;
+      }
+
       if ($tagString !== '') {
         $value .= '|'.$tagString;
       }
@@ -367,6 +590,20 @@ class UDP extends DriverBase {
       $this->reportMetric("$stat:$value");
     }
 
+    if ($aggregator !== null && $aggregator->shouldFlush() === true) {
+      $this->flushAggregates();
+    }
+
+    // Lines keep packing across calls, the datagram goes out when the next
+    // line does not fit, once it is older than the age threshold, or at
+    // shutdown. Deferred mode queues full datagrams instead.
+    if ($this->_isDeferred !== true &&
+        $this->_packet !== '' &&
+        microtime(true) - $this->_packetStartedAt >=
+          $this->_maxPacketAgeSeconds) {
+      $this->flushPacket();
+    }
+
     return true;
 
   }
@@ -375,8 +612,55 @@ class UDP extends DriverBase {
     return $this->flush($udp_message);
   }
 
+  /**
+   * Adds the line to the pending datagram, sending the datagram first if the
+   * line would not fit.
+   */
   public function reportMetric(string $udp_message): bool {
-    return $this->report($udp_message);
+
+    if ($this->_packet === '') {
+      $this->startPacket($udp_message);
+      return true;
+    }
+
+    if (strlen($this->_packet) + 1 + strlen($udp_message) >
+        $this->_maxPayloadBytes) {
+      $this->flushPacket();
+      $this->startPacket($udp_message);
+      return true;
+    }
+
+    $this->_packet .= "\n".$udp_message;
+
+    return true;
+
+  }
+
+  /**
+   * Sends the pending datagram, if there is one.
+   */
+  public function flushPacket(): bool {
+
+    if ($this->_packet === '') {
+      return false;
+    }
+
+    $packet = $this->_packet;
+    $this->_packet = '';
+
+    return $this->flush($packet);
+
+  }
+
+  public function getPendingPacket(): string {
+    return $this->_packet;
+  }
+
+  private function startPacket(string $udp_message): void {
+    $this->_packet = $udp_message;
+    $this->_packetStartedAt = microtime(true);
+    // A held datagram must not be lost when the request ends.
+    $this->registerShutdownFlush();
   }
 
   public function openSocket(): bool {
@@ -385,16 +669,70 @@ class UDP extends DriverBase {
       return true;
     }
 
+    $socket = $this->createSocket();
+
+    if (!is_resource($socket)) {
+      return false;
+    }
+
+    $this->_socket = $socket;
+
+    return true;
+
+  }
+
+  protected function createSocket(): mixed {
+
     // stand up the socket.
     $socket = socket_create(AF_INET, SOCK_DGRAM, SOL_UDP);
 
     // failed to set the socket to non-blocking.
     socket_set_nonblock($socket);
 
-    $this->_socket = $socket;
+    return $socket;
 
-    return true;
+  }
 
+  /**
+   * Writes one datagram to the agent, returns the bytes sent or false. A
+   * full or missing socket is counted as a drop, not raised as a warning.
+   */
+  protected function sendDatagram(resource $socket, string $message): mixed {
+    return @socket_sendto(
+      $socket,
+      $message,
+      strlen($message),
+      0,
+      $this->getServerHostname(),
+      $this->getServerPort(),
+    );
+  }
+
+  public function getServerHostname(): string {
+    $hostname = $this->_serverHostname;
+    if ($hostname === null) {
+      return $this->getConfig()->getServerHostname();
+    }
+    return $hostname;
+  }
+
+  public function getServerPort(): int {
+    $port = $this->_serverPort;
+    if ($port === null) {
+      return $this->getConfig()->getServerPort();
+    }
+    return $port;
+  }
+
+  /**
+   * Points this driver somewhere other than its config, a local listener
+   * in a test or benchmark.
+   */
+  public function setServerAddress(string $hostname, int $port): bool {
+    $this->flushPacket();
+    $this->_serverHostname = $hostname;
+    $this->_serverPort = $port;
+    return true;
   }
 
   public function closeSocket(): bool {
@@ -414,19 +752,27 @@ class UDP extends DriverBase {
     //if ( $this->openSocket() !== true ) {
     //  return false;
     //}
+    if ($this->_isDeferred === true && $this->_isDraining !== true) {
+      $this->_deferredPackets->add($udp_message);
+      if ($this->_deferredPackets->count() >= self::MAX_DEFERRED_PACKETS) {
+        $this->flushDeferred();
+      }
+      return true;
+    }
     $this->openSocket();
-    $config = $this->getConfig();
-    $server = $config->getServerHostname();
-    $port = $config->getServerPort();
+    $socket = $this->_socket;
+    if ($socket === null) {
+      $this->_packetsDropped++;
+      return true;
+    }
     $messageLength = strlen($udp_message);
-    $sentBytes = socket_sendto(
-      $this->_socket,
-      $udp_message,
-      $messageLength,
-      0,
-      $server,
-      $port,
-    );
+    $sentBytes = $this->sendDatagram($socket, $udp_message);
+    if ($sentBytes === $messageLength) {
+      $this->_packetsSent++;
+      $this->_bytesSent += $messageLength;
+    } else {
+      $this->_packetsDropped++;
+    }
     return true;
   }
 }
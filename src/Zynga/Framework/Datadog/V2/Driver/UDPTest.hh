@@ -2,6 +2,8 @@
 
 namespace Zynga\Framework\Datadog\V2;
 
+use Zynga\Framework\Datadog\V2\Aggregation\Aggregator;
+use Zynga\Framework\Datadog\V2\Config\Poker\Dev as PokerDevConfig;
 use Zynga\Framework\Datadog\V2\Driver\UDP;
 use Zynga\Framework\Datadog\V2\Factory as DatadogFactory;
 use
@@ -102,4 +104,163 @@ class UDPTest extends TestCase {
     }
 
   }
+
+  public function testAggregation(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+
+    $this->assertEquals(null, $dog->getAggregator());
+    $this->assertFalse($dog->flushAggregates());
+
+    $this->assertTrue($dog->enableAggregation(100, 3600.0));
+
+    for ($i = 0; $i < 50; $i++) {
+      $this->assertTrue($dog->increment('testStat'));
+    }
+    $this->assertTrue($dog->gauge('testGauge', 2.0));
+    $this->assertTrue($dog->event('testTitle', 'testText'));
+
+    $aggregator = $dog->getAggregator();
+    $this->assertTrue($aggregator instanceof Aggregator);
+
+    if ($aggregator instanceof Aggregator) {
+      $this->assertEquals(2, $aggregator->getContextCount());
+      $this->assertTrue($dog->flushAggregates());
+      $this->assertEquals(0, $aggregator->getContextCount());
+    }
+
+    $this->assertTrue($dog->disableAggregation());
+    $this->assertEquals(null, $dog->getAggregator());
+
+  }
+
+  public function testAggregationFlushesAtMaxContexts(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+    $dog->enableAggregation(3, 3600.0);
+
+    $dog->increment('a');
+    $dog->increment('b');
+
+    $aggregator = $dog->getAggregator();
+
+    if ($aggregator instanceof Aggregator) {
+      $this->assertEquals(2, $aggregator->getContextCount());
+      $dog->increment('c');
+      $this->assertEquals(0, $aggregator->getContextCount());
+    }
+
+  }
+
+  public function testPacking(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+    $this->assertEquals(
+      UDP::DEFAULT_MAX_PAYLOAD_BYTES,
+      $dog->getMaxPayloadBytes(),
+    );
+
+    $this->assertTrue($dog->setMaxPayloadBytes(10));
+    $this->assertFalse($dog->flushPacket());
+
+    $dog->reportMetric('aaaa');
+    $dog->reportMetric('bbbb');
+    $this->assertEquals("aaaa\nbbbb", $dog->getPendingPacket());
+    $this->assertEquals(0, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+    $dog->reportMetric('cc');
+    $this->assertEquals('cc', $dog->getPendingPacket());
+    $this->assertEquals(1, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+    // Too long to share, still goes out alone.
+    $dog->reportMetric('this-line-is-long');
+    $this->assertEquals('this-line-is-long', $dog->getPendingPacket());
+
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals('', $dog->getPendingPacket());
+    $this->assertEquals(3, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+  }
+
+  public function testPackingBurst(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+
+    $stats = Map {};
+    for ($i = 0; $i < 100; $i++) {
+      $stats['stat.'.$i] = 1.0;
+    }
+
+    $this->assertTrue($dog->histogramStats($stats));
+    $this->assertEquals(0, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals('', $dog->getPendingPacket());
+    $this->assertEquals(1, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+    if ($dog->getPacketsDropped() == 0) {
+      $this->assertGreaterThan(1000, $dog->getBytesSent());
+    }
+
+  }
+
+  public function testPackingAcrossCalls(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+    $dog->setMaxPacketAgeSeconds(3600.0);
+
+    // Separate calls share the datagram until it fills or ages out.
+    for ($i = 0; $i < 50; $i++) {
+      $this->assertTrue($dog->increment('testStat'));
+    }
+
+    $this->assertEquals(0, $dog->getPacketsSent() + $dog->getPacketsDropped());
+    $this->assertEquals(
+      50,
+      count(explode("\n", $dog->getPendingPacket())),
+    );
+
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals(1, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+    // No age allowance, every call goes straight out.
+    $this->assertTrue($dog->setMaxPacketAgeSeconds(0.0));
+    $this->assertTrue($dog->increment('testStat'));
+    $this->assertEquals('', $dog->getPendingPacket());
+    $this->assertEquals(2, $dog->getPacketsSent() + $dog->getPacketsDropped());
+
+  }
+
+  public function testEventIsNotPacked(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+    $dog->setMaxPacketAgeSeconds(3600.0);
+    $this->assertTrue($dog->increment('testStat'));
+
+    $pending = $dog->getPendingPacket();
+    $this->assertNotEquals('', $pending);
+
+    // The event leaves on its own, the metric line stays pending.
+    $this->assertTrue($dog->event('testTitle', 'testText'));
+    $this->assertEquals($pending, $dog->getPendingPacket());
+
+  }
+
+  public function testHistogramSketches(): void {
+
+    $dog = new UDP(new PokerDevConfig());
+    $this->assertTrue($dog->enableHistogramSketches());
+
+    $aggregator = $dog->getAggregator();
+    $this->assertTrue($aggregator instanceof Aggregator);
+
+    if ($aggregator instanceof Aggregator) {
+      $this->assertTrue($aggregator->getUseSketches());
+      for ($i = 0; $i < 100; $i++) {
+        $dog->timing('testTiming', $i / 1000.0);
+      }
+      $this->assertEquals(1, $aggregator->getContextCount());
+    }
+
+  }
 }
@@ -0,0 +1,71 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Driver;
+
+use Zynga\Framework\Datadog\V2\Driver\UDP;
+use Zynga\Framework\Datadog\V2\Interfaces\DriverConfigInterface;
+use Zynga\Framework\Datadog\V2\Interfaces\UDSDriverConfigInterface;
+
+/**
+ * Writes the same DogStatsD datagrams as the UDP driver to the agent's unix
+ * datagram socket. No DNS lookup, no kernel UDP drops, and when the agent
+ * falls behind the non-blocking write fails and shows up in
+ * getPacketsDropped() instead of vanishing.
+ */
+class UDS extends UDP {
+  const string DEFAULT_SOCKET_PATH = '/var/run/datadog/dsd.socket';
+
+  // The agent reads up to 8k per datagram off the socket.
+  const int DEFAULT_MAX_UDS_PAYLOAD_BYTES = 8192;
+
+  private string $_socketPath;
+
+  public function __construct(DriverConfigInterface $config) {
+
+    parent::__construct($config);
+
+    $this->_socketPath = self::DEFAULT_SOCKET_PATH;
+
+    if ($config instanceof UDSDriverConfigInterface) {
+      $this->_socketPath = $config->getSocketPath();
+    }
+
+    $this->setMaxPayloadBytes(self::DEFAULT_MAX_UDS_PAYLOAD_BYTES);
+
+  }
+
+  public function getSocketPath(): string {
+    return $this->_socketPath;
+  }
+
+  public function setSocketPath(string $socketPath): bool {
+    $this->flushPacket();
+    $this->_socketPath = $socketPath;
+    return true;
+  }
+
+  protected function createSocket(): mixed {
+
+    $socket = socket_create(AF_UNIX, SOCK_DGRAM, 0);
+
+    if (!is_resource($socket)) {
+      return false;
+    }
+
+    socket_set_nonblock($socket);
+
+    return $socket;
+
+  }
+
+  protected function sendDatagram(resource $socket, string $message): mixed {
+    return @socket_sendto(
+      $socket,
+      $message,
+      strlen($message),
+      0,
+      $this->_socketPath,
+    );
+  }
+
+}
@@ -0,0 +1,192 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2;
+
+use Zynga\Framework\Datadog\V2\Config\Poker\Dev as PokerDevConfig;
+use Zynga\Framework\Datadog\V2\Config\UDS\Dev as UDSDevConfig;
+use Zynga\Framework\Datadog\V2\Driver\UDP;
+use Zynga\Framework\Datadog\V2\Driver\UDS;
+use Zynga\Framework\Datadog\V2\TagSet;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class UDSTest extends TestCase {
+
+  private string $_socketPath = '';
+  private ?resource $_listener;
+
+  public function setUp(): void {
+
+    parent::setUp();
+
+    $this->_socketPath =
+      sys_get_temp_dir().'/zfw-dsd-test-'.getmypid().'.sock';
+
+    if (file_exists($this->_socketPath)) {
+      unlink($this->_socketPath);
+    }
+
+    $listener = socket_create(AF_UNIX, SOCK_DGRAM, 0);
+    socket_bind($listener, $this->_socketPath);
+    socket_set_nonblock($listener);
+
+    $this->_listener = $listener;
+
+  }
+
+  public function tearDown(): void {
+
+    if (is_resource($this->_listener)) {
+      socket_close($this->_listener);
+      $this->_listener = null;
+    }
+
+    if (file_exists($this->_socketPath)) {
+      unlink($this->_socketPath);
+    }
+
+    parent::tearDown();
+
+  }
+
+  private function createDriver(): UDS {
+    $dog = new UDS(new UDSDevConfig());
+    $dog->setSocketPath($this->_socketPath);
+    return $dog;
+  }
+
+  private function receive(): string {
+    $buffer = '';
+    $from = '';
+    if (is_resource($this->_listener)) {
+      socket_recvfrom($this->_listener, $buffer, 65536, 0, $from);
+    }
+    return strval($buffer);
+  }
+
+  public function testConfig(): void {
+
+    $dog = new UDS(new UDSDevConfig());
+    $this->assertEquals('/var/run/datadog/dsd.socket', $dog->getSocketPath());
+    $this->assertEquals(
+      UDS::DEFAULT_MAX_UDS_PAYLOAD_BYTES,
+      $dog->getMaxPayloadBytes(),
+    );
+
+    // Configs without a socket path fall back to the agent default.
+    $dog = new UDS(new PokerDevConfig());
+    $this->assertEquals(UDS::DEFAULT_SOCKET_PATH, $dog->getSocketPath());
+
+  }
+
+  public function testSend(): void {
+
+    $dog = $this->createDriver();
+    $this->assertTrue($dog instanceof UDP);
+
+    $this->assertTrue($dog->increment('testStat'));
+    $this->assertTrue($dog->gauge('testGauge', 2.0));
+    $this->assertTrue($dog->flushPacket());
+
+    $this->assertEquals("testStat:1|c\ntestGauge:2|g", $this->receive());
+
+    $this->assertEquals(1, $dog->getPacketsSent());
+    $this->assertEquals(0, $dog->getPacketsDropped());
+
+  }
+
+  public function testSendPacked(): void {
+
+    $dog = $this->createDriver();
+
+    $this->assertTrue($dog->incrementStats(Vector {'a', 'b'}));
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals("a:1|c\nb:1|c", $this->receive());
+    $this->assertEquals(1, $dog->getPacketsSent());
+
+  }
+
+  public function testMissingSocketCountsAsDrop(): void {
+
+    $dog = $this->createDriver();
+    $dog->setSocketPath($this->_socketPath.'.missing');
+
+    $this->assertTrue($dog->increment('testStat'));
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals(0, $dog->getPacketsSent());
+    $this->assertEquals(1, $dog->getPacketsDropped());
+
+  }
+
+  public function testTags(): void {
+
+    $dog = $this->createDriver();
+
+    $tags = Map {'x' => '1', 'y' => '2'};
+    $this->assertTrue($dog->increment('a', 1.0, $tags));
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals('a:1|c|#x:1,y:2', $this->receive());
+
+    $this->assertTrue($dog->setDefaultTags(Map {'env' => 'dev'}));
+    $this->assertEquals('#env:dev', $dog->getDefaultTags()->toWire());
+
+    $this->assertTrue($dog->increment('a'));
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals('a:1|c|#env:dev', $this->receive());
+
+    $tagSet = TagSet::intern(Map {'x' => '1'});
+    $this->assertTrue($dog->increment('a', 1.0, $tagSet));
+    $this->assertTrue($dog->flushPacket());
+    $this->assertEquals('a:1|c|#env:dev,x:1', $this->receive());
+
+  }
+
+  public function testDeferredFlush(): void {
+
+    $dog = $this->createDriver();
+    $this->assertFalse($dog->getIsDeferred());
+
+    $this->assertTrue($dog->enableDeferredFlush());
+    $this->assertTrue($dog->getIsDeferred());
+
+    $this->assertTrue($dog->increment('a'));
+    $this->assertTrue($dog->increment('b'));
+    $this->assertTrue($dog->serviceCheck('check', 0));
+
+    // Nothing has touched the socket yet.
+    $this->assertEquals(0, $dog->getPacketsSent());
+    $this->assertEquals("a:1|c\nb:1|c", $dog->getPendingPacket());
+    $this->assertEquals(1, $dog->getDeferredPacketCount());
+
+    $this->assertTrue($dog->flushDeferred());
+
+    $this->assertEquals('_sc|check|0', $this->receive());
+    $this->assertEquals("a:1|c\nb:1|c", $this->receive());
+    $this->assertEquals(2, $dog->getPacketsSent());
+    $this->assertEquals(0, $dog->getDeferredPacketCount());
+
+    $this->assertTrue($dog->disableDeferredFlush());
+    $this->assertFalse($dog->getIsDeferred());
+
+  }
+
+  public function testDeferredQueuesFullPackets(): void {
+
+    $dog = $this->createDriver();
+    $dog->enableDeferredFlush();
+    $dog->setMaxPayloadBytes(12);
+
+    $dog->increment('a');
+    $dog->increment('b');
+    $dog->increment('c');
+
+    $this->assertEquals(1, $dog->getDeferredPacketCount());
+    $this->assertEquals('c:1|c', $dog->getPendingPacket());
+
+    $dog->flushDeferred();
+
+    $this->assertEquals("a:1|c\nb:1|c", $this->receive());
+    $this->assertEquals('c:1|c', $this->receive());
+
+  }
+
+}
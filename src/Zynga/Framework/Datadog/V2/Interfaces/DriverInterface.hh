@@ -3,6 +3,7 @@
 namespace Zynga\Framework\Datadog\V2\Interfaces;
 
 use Zynga\Framework\Datadog\V2\Interfaces\DriverConfigInterface;
+use Zynga\Framework\Datadog\V2\TagSet;
 use
   Zynga\Framework\Factory\V2\Interfaces\DriverInterface as BaseDriverInterface
 ;
@@ -39,19 +40,35 @@ interface DriverInterface extends BaseDriverInterface {
    **/
   public function shouldSample(float $sampleRate, bool $forceSample): bool;
 
+  /**
+   * Returns the tags added to every metric sent by this driver
+   *
+   * @return The default tags, empty if none were set
+   **/
+  public function getDefaultTags(): TagSet;
+
+  /**
+   * Sets the tags added to every metric sent by this driver, ahead of any
+   * tags given on the call itself.
+   *
+   * @param $tags Tag => Value, a Map or TagSet
+   * @return True if successful, otherwise false
+   **/
+  public function setDefaultTags(KeyedTraversable<string, string> $tags): bool;
+
   /**
    * Log timing information
    *
    * @param string $stat The metric to in log timing info for.
    * @param float $time The elapsed time in seconds to log
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param ?Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function timing(
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -60,13 +77,13 @@ interface DriverInterface extends BaseDriverInterface {
    * @param string $stat The metric name
    * @param float $time The elapsed time in microseconds to log
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param array|string $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function microTiming(
     string $stat,
     float $time,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -75,13 +92,13 @@ interface DriverInterface extends BaseDriverInterface {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param array|string $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    **/
   public function gauge(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -90,14 +107,14 @@ interface DriverInterface extends BaseDriverInterface {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function histogram(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -105,13 +122,13 @@ interface DriverInterface extends BaseDriverInterface {
    *
    * @param Map<string,float> $stats The metrics you would like to update
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function histogramStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -120,14 +137,14 @@ interface DriverInterface extends BaseDriverInterface {
    * @param string $stat The metric
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function set(
     string $stat,
     float $value,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -145,13 +162,13 @@ interface DriverInterface extends BaseDriverInterface {
    * @param Map<string, float> $stats The metrics you would like to update
    * @param float $value The value
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function setStats(
     Map<string, float> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -159,13 +176,13 @@ interface DriverInterface extends BaseDriverInterface {
    *
    * @param string $stat The metric to increment.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function increment(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -173,13 +190,13 @@ interface DriverInterface extends BaseDriverInterface {
    *
    * @param Vector<string> $stats The metrics to increment.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function incrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -187,13 +204,13 @@ interface DriverInterface extends BaseDriverInterface {
    *
    * @param string $stat The metric to decrement.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function decrement(
     string $stat,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
@@ -201,20 +218,20 @@ interface DriverInterface extends BaseDriverInterface {
    *
    * @param Vector<string> $stats The metrics to decrement.
    * @param float $sampleRate the rate (0-1) for sampling.
-   * @param Map<string,mixed> $tags Key Value array of Tag => Value
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @return bool
    **/
   public function decrementStats(
     Vector<string> $stats,
     float $sampleRate = 1.0,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
   ): bool;
 
   /**
    * Send a custom service check status.
    * @param string $name service check name
    * @param int $status service check status code (see static::OK, static::WARNING,...)
-   * @param ?Map<string,string> $tags Key Value array of Tag => Value, or single tag as string
+   * @param ?KeyedTraversable<string,string> $tags Tag => Value, a Map or TagSet
    * @param ?string $hostname hostname to associate with this service check status
    * @param ?string $message message to associate with this service check status
    * @param ?int $timestamp timestamp for the service check status (defaults to now)
@@ -223,7 +240,7 @@ interface DriverInterface extends BaseDriverInterface {
   public function serviceCheck(
     string $name,
     int $status,
-    ?Map<string, string> $tags = null,
+    ?KeyedTraversable<string, string> $tags = null,
     ?string $hostname = null,
     ?string $message = null,
     ?int $timestamp = null,
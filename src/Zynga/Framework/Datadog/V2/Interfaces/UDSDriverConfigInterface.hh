@@ -0,0 +1,12 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Interfaces;
+
+use Zynga\Framework\Datadog\V2\Interfaces\DriverConfigInterface;
+
+interface UDSDriverConfigInterface extends DriverConfigInterface {
+  /**
+   * Path of the unix datagram socket the agent listens on
+   **/
+  public function getSocketPath(): string;
+}
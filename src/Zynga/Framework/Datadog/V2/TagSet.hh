@@ -0,0 +1,158 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2;
+
+/**
+ * An immutable set of tags with its DogStatsD wire form ('#k:v,k2:v2')
+ * rendered once up front. Build the static tag sets a call site uses with
+ * TagSet::intern() and hand the same object to every metric call, the
+ * driver then appends the pre-rendered string instead of walking a Map.
+ *
+ * Iterates like the Map it was built from, so it can be passed anywhere
+ * tags are accepted. Every foreach gets its own iterator over the tags, an
+ * interned set is shared so it must not carry a cursor of its own.
+ */
+final class TagSet implements KeyedIterable<string, string> {
+  // The rest of KeyedIterable is derived from getIterator().
+  use \StrictKeyedIterable<string, string>;
+
+  // Past this many distinct sets intern() stops caching, a call site that
+  // builds tags from request data should not grow the table forever.
+  const int MAX_INTERNED = 1000;
+
+  private static Map<string, TagSet> $_interned = Map {};
+  private static ?TagSet $_empty;
+
+  private ImmMap<string, string> $_tags;
+  private string $_wire;
+
+  public function __construct(KeyedTraversable<string, string> $tags) {
+
+    $this->_tags = new ImmMap($tags);
+    $this->_wire = self::render($this->_tags);
+
+  }
+
+  /**
+   * Returns a shared TagSet for these tags, building it on first use.
+   */
+  public static function intern(KeyedTraversable<string, string> $tags): TagSet {
+
+    if ($tags instanceof TagSet) {
+      return $tags;
+    }
+
+    $wire = self::render($tags);
+
+    $tagSet = self::$_interned->get($wire);
+
+    if ($tagSet !== null) {
+      return $tagSet;
+    }
+
+    $tagSet = new TagSet($tags);
+
+    if (self::$_interned->count() < self::MAX_INTERNED) {
+      self::$_interned->set($wire, $tagSet);
+    }
+
+    return $tagSet;
+
+  }
+
+  public static function getInternedCount(): int {
+    return self::$_interned->count();
+  }
+
+  public static function clearInterned(): bool {
+    self::$_interned->clear();
+    return true;
+  }
+
+  public static function none(): TagSet {
+    $empty = self::$_empty;
+    if ($empty === null) {
+      $empty = new TagSet(Map {});
+      self::$_empty = $empty;
+    }
+    return $empty;
+  }
+
+  /**
+   * Wire form of any tag collection, '' when there are no tags.
+   */
+  public static function render(?KeyedTraversable<string, string> $tags): string {
+
+    if ($tags === null) {
+      return '';
+    }
+
+    if ($tags instanceof TagSet) {
+      return $tags->toWire();
+    }
+
+    $wire = '';
+
+    foreach ($tags as $key => $value) {
+      $wire .= ($wire === '') ? '#' : ',';
+      $wire .= $key.':'.$value;
+    }
+
+    return $wire;
+
+  }
+
+  /**
+   * Joins two wire forms, either of which may be empty.
+   */
+  public static function concatWire(string $first, string $second): string {
+
+    if ($first === '') {
+      return $second;
+    }
+
+    if ($second === '') {
+      return $first;
+    }
+
+    return $first.','.substr($second, 1);
+
+  }
+
+  public function toWire(): string {
+    return $this->_wire;
+  }
+
+  public function toMap(): Map<string, string> {
+    return $this->_tags->toMap();
+  }
+
+  public function count(): int {
+    return $this->_tags->count();
+  }
+
+  public function isEmpty(): bool {
+    return $this->_tags->isEmpty();
+  }
+
+  public function get(string $key): ?string {
+    return $this->_tags->get($key);
+  }
+
+  /**
+   * A new set holding these tags plus $tags, later values win on a key
+   * collision.
+   */
+  public function with(KeyedTraversable<string, string> $tags): TagSet {
+    $merged = $this->_tags->toMap();
+    foreach ($tags as $key => $value) {
+      $merged->set($key, $value);
+    }
+    return self::intern($merged);
+  }
+
+  public function getIterator(): KeyedIterator<string, string> {
+    return $this->_tags->getIterator();
+  }
+
+}
@@ -0,0 +1,96 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2;
+
+use Zynga\Framework\Datadog\V2\TagSet;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class TagSetTest extends TestCase {
+
+  public function testWire(): void {
+
+    $tags = new TagSet(Map {'env' => 'dev', 'app' => 'poker'});
+
+    $this->assertEquals('#env:dev,app:poker', $tags->toWire());
+    $this->assertEquals(2, $tags->count());
+    $this->assertEquals('poker', $tags->get('app'));
+    $this->assertEquals(null, $tags->get('nope'));
+
+    $this->assertEquals('', TagSet::none()->toWire());
+    $this->assertTrue(TagSet::none()->isEmpty());
+
+  }
+
+  public function testRender(): void {
+    $this->assertEquals('', TagSet::render(null));
+    $this->assertEquals('', TagSet::render(Map {}));
+    $this->assertEquals('#a:b', TagSet::render(Map {'a' => 'b'}));
+    $this->assertEquals('#a:b', TagSet::render(new TagSet(Map {'a' => 'b'})));
+  }
+
+  public function testConcat(): void {
+    $this->assertEquals('', TagSet::concatWire('', ''));
+    $this->assertEquals('#a:b', TagSet::concatWire('#a:b', ''));
+    $this->assertEquals('#c:d', TagSet::concatWire('', '#c:d'));
+    $this->assertEquals('#a:b,c:d', TagSet::concatWire('#a:b', '#c:d'));
+  }
+
+  public function testIntern(): void {
+
+    TagSet::clearInterned();
+
+    $first = TagSet::intern(Map {'a' => 'b'});
+    $second = TagSet::intern(Map {'a' => 'b'});
+
+    $this->assertSame($first, $second);
+    $this->assertSame($first, TagSet::intern($first));
+    $this->assertEquals(1, TagSet::getInternedCount());
+
+    $this->assertTrue(TagSet::clearInterned());
+    $this->assertEquals(0, TagSet::getInternedCount());
+
+  }
+
+  public function testWith(): void {
+
+    $tags = new TagSet(Map {'a' => 'b'});
+    $merged = $tags->with(Map {'a' => 'c', 'd' => 'e'});
+
+    $this->assertEquals('#a:b', $tags->toWire());
+    $this->assertEquals('#a:c,d:e', $merged->toWire());
+
+  }
+
+  public function testIteratesLikeMap(): void {
+
+    $source = Map {'a' => 'b', 'c' => 'd'};
+    $tags = new TagSet($source);
+
+    $seen = Map {};
+    foreach ($tags as $key => $value) {
+      $seen->set($key, $value);
+    }
+
+    $this->assertEquals($source, $seen);
+    $this->assertEquals($source, $tags->toMap());
+
+  }
+
+  public function testNestedIteration(): void {
+
+    // Interned sets are shared, iterating one inside a loop over the same
+    // set must not disturb the outer loop.
+    $tags = TagSet::intern(Map {'a' => 'b', 'c' => 'd'});
+
+    $pairs = Vector {};
+    foreach ($tags as $outer => $outerValue) {
+      foreach (TagSet::intern(Map {'a' => 'b', 'c' => 'd'}) as $inner => $v) {
+        $pairs->add($outer.$inner);
+      }
+    }
+
+    $this->assertEquals(Vector {'aa', 'ac', 'ca', 'cc'}, $pairs);
+
+  }
+
+}
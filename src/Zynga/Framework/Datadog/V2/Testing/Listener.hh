@@ -0,0 +1,220 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Testing;
+
+use Zynga\Framework\Datadog\V2\Testing\Metric;
+use Zynga\Framework\Exception\V1\Exception;
+
+/**
+ * Stand-in for the agent's DogStatsD listener, bound to loopback UDP or a
+ * unix datagram socket in the current process. Call receive() to pull
+ * whatever has arrived, then inspect the parsed metrics and the packet /
+ * byte totals.
+ *
+ * Nothing reads the socket in the background, datagrams that arrive while
+ * nobody is calling receive() queue in the kernel until its buffer fills
+ * and the rest are lost, the same as a stalled agent.
+ */
+class Listener {
+  const int MAX_DATAGRAM_BYTES = 65536;
+
+  private ?resource $_socket;
+  private string $_address;
+  private int $_port;
+  private bool $_isUnix;
+
+  private int $_packets;
+  private int $_bytes;
+  private int $_malformed;
+  private Vector<Metric> $_metrics;
+
+  private function __construct(resource $socket, string $address, int $port) {
+    $this->_socket = $socket;
+    $this->_address = $address;
+    $this->_port = $port;
+    $this->_isUnix = ($port == 0);
+    $this->_packets = 0;
+    $this->_bytes = 0;
+    $this->_malformed = 0;
+    $this->_metrics = Vector {};
+  }
+
+  public function __destruct() {
+    $this->close();
+  }
+
+  /**
+   * Binds 127.0.0.1, port 0 picks a free one, see getPort().
+   */
+  public static function udp(int $port = 0): Listener {
+
+    $socket = socket_create(AF_INET, SOCK_DGRAM, SOL_UDP);
+
+    if (!is_resource($socket) || !socket_bind($socket, '127.0.0.1', $port)) {
+      throw new Exception('Failed to bind udp listener port='.$port);
+    }
+
+    $address = '';
+    socket_getsockname($socket, $address, $port);
+
+    socket_set_nonblock($socket);
+
+    return new Listener($socket, strval($address), intval($port));
+
+  }
+
+  /**
+   * Binds a unix datagram socket at $path, replacing a stale one.
+   */
+  public static function uds(string $path): Listener {
+
+    if (file_exists($path)) {
+      unlink($path);
+    }
+
+    $socket = socket_create(AF_UNIX, SOCK_DGRAM, 0);
+
+    if (!is_resource($socket) || !socket_bind($socket, $path)) {
+      throw new Exception('Failed to bind uds listener path='.$path);
+    }
+
+    socket_set_nonblock($socket);
+
+    return new Listener($socket, $path, 0);
+
+  }
+
+  public function getAddress(): string {
+    return $this->_address;
+  }
+
+  public function getPort(): int {
+    return $this->_port;
+  }
+
+  /**
+   * Reads every datagram waiting on the socket, waiting up to $timeout
+   * seconds for the first one. Returns the number of datagrams read.
+   */
+  public function receive(float $timeout = 0.0): int {
+
+    $socket = $this->_socket;
+
+    if ($socket === null) {
+      return 0;
+    }
+
+    $read = array($socket);
+    $write = null;
+    $except = null;
+
+    $seconds = (int) $timeout;
+    $micros = (int) (($timeout - $seconds) * 1000000);
+
+    if (socket_select($read, $write, $except, $seconds, $micros) < 1) {
+      return 0;
+    }
+
+    $received = 0;
+
+    while (true) {
+
+      $buffer = '';
+      $from = '';
+      $length = @socket_recvfrom(
+        $socket,
+        $buffer,
+        self::MAX_DATAGRAM_BYTES,
+        0,
+        $from,
+      );
+
+      if ($length === false || $length < 1) {
+        break;
+      }
+
+      $received++;
+      $this->_packets++;
+      $this->_bytes += $length;
+
+      foreach (explode("\n", strval($buffer)) as $line) {
+        if ($line === '') {
+          continue;
+        }
+        $metric = Metric::parse($line);
+        if ($metric === null) {
+          $this->_malformed++;
+        } else {
+          $this->_metrics->add($metric);
+        }
+      }
+
+    }
+
+    return $received;
+
+  }
+
+  public function getPacketCount(): int {
+    return $this->_packets;
+  }
+
+  public function getByteCount(): int {
+    return $this->_bytes;
+  }
+
+  public function getMalformedCount(): int {
+    return $this->_malformed;
+  }
+
+  public function getMetrics(): Vector<Metric> {
+    return $this->_metrics;
+  }
+
+  public function getLines(): Vector<string> {
+    return $this->_metrics->map($metric ==> $metric->line);
+  }
+
+  public function getMetricsNamed(string $name): Vector<Metric> {
+    return $this->_metrics->filter($metric ==> $metric->name === $name);
+  }
+
+  /**
+   * What the agent would count for $name across everything received.
+   */
+  public function getTotal(string $name): float {
+    $total = 0.0;
+    foreach ($this->getMetricsNamed($name) as $metric) {
+      $total += $metric->getTotal();
+    }
+    return $total;
+  }
+
+  public function clear(): bool {
+    $this->_packets = 0;
+    $this->_bytes = 0;
+    $this->_malformed = 0;
+    $this->_metrics = Vector {};
+    return true;
+  }
+
+  public function close(): bool {
+
+    $socket = $this->_socket;
+
+    if ($socket === null) {
+      return false;
+    }
+
+    socket_close($socket);
+    $this->_socket = null;
+
+    if ($this->_isUnix === true && file_exists($this->_address)) {
+      unlink($this->_address);
+    }
+
+    return true;
+
+  }
+
+}
@@ -0,0 +1,115 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2\Testing;
+
+use Zynga\Framework\Datadog\V2\Config\Poker\Dev as PokerDevConfig;
+use Zynga\Framework\Datadog\V2\Config\UDS\Dev as UDSDevConfig;
+use Zynga\Framework\Datadog\V2\Driver\UDP;
+use Zynga\Framework\Datadog\V2\Driver\UDS;
+use Zynga\Framework\Datadog\V2\Testing\Listener;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class ListenerTest extends TestCase {
+
+  private function createUDP(Listener $listener): UDP {
+    $dog = new UDP(new PokerDevConfig());
+    $dog->setServerAddress($listener->getAddress(), $listener->getPort());
+    return $dog;
+  }
+
+  public function testUDP(): void {
+
+    $listener = Listener::udp();
+    $this->assertGreaterThan(0, $listener->getPort());
+
+    $dog = $this->createUDP($listener);
+    $this->assertEquals($listener->getPort(), $dog->getServerPort());
+
+    $dog->increment('hits', 1.0, Map {'env' => 'dev'});
+    $dog->gauge('depth', 3.0);
+    $dog->flushPacket();
+
+    // Both calls packed into the one datagram.
+    $this->assertEquals(1, $listener->receive(1.0));
+    $this->assertEquals(1, $listener->getPacketCount());
+    $this->assertEquals($dog->getBytesSent(), $listener->getByteCount());
+    $this->assertEquals(
+      Vector {'hits:1|c|#env:dev', 'depth:3|g'},
+      $listener->getLines(),
+    );
+    $this->assertEquals(0, $listener->getMalformedCount());
+
+    $this->assertTrue($listener->clear());
+    $this->assertEquals(0, $listener->getPacketCount());
+    $this->assertEquals(0, $listener->receive());
+
+    $this->assertTrue($listener->close());
+    $this->assertFalse($listener->close());
+
+  }
+
+  public function testUDS(): void {
+
+    $path = sys_get_temp_dir().'/zfw-dsd-listener-'.getmypid().'.sock';
+    $listener = Listener::uds($path);
+    $this->assertEquals($path, $listener->getAddress());
+
+    $dog = new UDS(new UDSDevConfig());
+    $dog->setSocketPath($path);
+    $dog->incrementStats(Vector {'a', 'b'});
+    $dog->flushPacket();
+
+    $this->assertEquals(1, $listener->receive(1.0));
+    $this->assertEquals(Vector {'a:1|c', 'b:1|c'}, $listener->getLines());
+
+    $listener->close();
+    $this->assertFalse(file_exists($path));
+
+  }
+
+  public function testAggregationEndToEnd(): void {
+
+    $listener = Listener::udp();
+    $dog = $this->createUDP($listener);
+    $dog->enableAggregation(1000, 3600.0);
+
+    for ($i = 0; $i < 50; $i++) {
+      $dog->increment('hits');
+      $dog->increment('sampled', 0.5, null);
+    }
+    $dog->flushAggregates();
+
+    $listener->receive(1.0);
+
+    // One packet carrying one summed line per counter.
+    $this->assertEquals(1, $listener->getPacketCount());
+    $this->assertEquals(1, $listener->getMetricsNamed('hits')->count());
+    $this->assertEquals(50.0, $listener->getTotal('hits'));
+
+  }
+
+  public function testPackingEndToEnd(): void {
+
+    $listener = Listener::udp();
+    $dog = $this->createUDP($listener);
+
+    $stats = Vector {};
+    for ($i = 0; $i < 500; $i++) {
+      $stats->add('stat.'.$i);
+    }
+    $dog->incrementStats($stats);
+    $dog->flushPacket();
+
+    $listener->receive(1.0);
+
+    $this->assertEquals($dog->getPacketsSent(), $listener->getPacketCount());
+    $this->assertLessThan(10, $listener->getPacketCount());
+    $this->assertEquals(500, $listener->getMetrics()->count());
+
+    foreach ($listener->getMetrics() as $metric) {
+      $this->assertEquals(1.0, $metric->getTotal());
+    }
+
+  }
+
+}
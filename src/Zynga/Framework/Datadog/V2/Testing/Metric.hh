@@ -0,0 +1,116 @@
+<?hh // strict
+
+namespace Zynga\Framework\Datadog\V2\Testing;
+
+/**
+ * One DogStatsD line as the agent would read it,
+ * 'name:value[:value...]|type[|@rate][|#tags]'. Events and service checks
+ * are kept whole with the type set to TYPE_EVENT / TYPE_SERVICE_CHECK.
+ */
+class Metric {
+  const string TYPE_EVENT = '_e';
+  const string TYPE_SERVICE_CHECK = '_sc';
+
+  public string $line;
+  public string $name;
+  public string $type;
+  public Vector<string> $values;
+  public float $sampleRate;
+  public Map<string, string> $tags;
+
+  public function __construct(string $line, string $name, string $type) {
+    $this->line = $line;
+    $this->name = $name;
+    $this->type = $type;
+    $this->values = Vector {};
+    $this->sampleRate = 1.0;
+    $this->tags = Map {};
+  }
+
+  /**
+   * Returns null for anything the agent would reject as malformed.
+   */
+  public static function parse(string $line): ?Metric {
+
+    if (substr($line, 0, 3) === '_e{') {
+      $end = strpos($line, '}:');
+      if ($end === false) {
+        return null;
+      }
+      $parts = explode('|', substr($line, $end + 2));
+      return new Metric($line, $parts[0], self::TYPE_EVENT);
+    }
+
+    if (substr($line, 0, 4) === '_sc|') {
+      $parts = explode('|', $line);
+      if (count($parts) < 3) {
+        return null;
+      }
+      $metric = new Metric($line, $parts[1], self::TYPE_SERVICE_CHECK);
+      $metric->values->add($parts[2]);
+      self::parseExtensions($metric, array_slice($parts, 3));
+      return $metric;
+    }
+
+    $colon = strpos($line, ':');
+
+    if ($colon === false || $colon == 0) {
+      return null;
+    }
+
+    $parts = explode('|', substr($line, $colon + 1));
+
+    if (count($parts) < 2 || $parts[0] === '' || $parts[1] === '') {
+      return null;
+    }
+
+    $metric = new Metric($line, substr($line, 0, $colon), $parts[1]);
+
+    foreach (explode(':', $parts[0]) as $value) {
+      $metric->values->add($value);
+    }
+
+    self::parseExtensions($metric, array_slice($parts, 2));
+
+    return $metric;
+
+  }
+
+  private static function parseExtensions(
+    Metric $metric,
+    array<string> $extensions,
+  ): void {
+
+    foreach ($extensions as $extension) {
+
+      $prefix = substr($extension, 0, 1);
+
+      if ($prefix === '@') {
+        $metric->sampleRate = floatval(substr($extension, 1));
+      } else if ($prefix === '#') {
+        foreach (explode(',', substr($extension, 1)) as $tag) {
+          $pair = explode(':', $tag, 2);
+          $metric->tags->set($pair[0], count($pair) > 1 ? $pair[1] : '');
+        }
+      }
+
+    }
+
+  }
+
+  /**
+   * Sum of the values, scaled up by the sample rate the way the agent
+   * counts a sampled counter.
+   */
+  public function getTotal(): float {
+    $total = 0.0;
+    foreach ($this->values as $value) {
+      $total += floatval($value);
+    }
+    if ($this->sampleRate > 0.0) {
+      $total = $total / $this->sampleRate;
+    }
+    return $total;
+  }
+
+}
@@ -0,0 +1,68 @@
+<?hh //strict
+
+namespace Zynga\Framework\Datadog\V2\Testing;
+
+use Zynga\Framework\Datadog\V2\Testing\Metric;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class MetricTest extends TestCase {
+
+  public function testParseMetric(): void {
+
+    $metric = Metric::parse('hits:3|c|@0.5|#env:dev,canary');
+
+    $this->assertTrue($metric instanceof Metric);
+
+    if ($metric instanceof Metric) {
+      $this->assertEquals('hits', $metric->name);
+      $this->assertEquals('c', $metric->type);
+      $this->assertEquals(Vector {'3'}, $metric->values);
+      $this->assertEquals(0.5, $metric->sampleRate);
+      $this->assertEquals(Map {'env' => 'dev', 'canary' => ''}, $metric->tags);
+      $this->assertEquals(6.0, $metric->getTotal());
+    }
+
+  }
+
+  public function testParseMultiValue(): void {
+    $metric = Metric::parse('latency:1:2:3|h');
+    if ($metric instanceof Metric) {
+      $this->assertEquals(Vector {'1', '2', '3'}, $metric->values);
+      $this->assertEquals(6.0, $metric->getTotal());
+    } else {
+      $this->fail('expected a metric');
+    }
+  }
+
+  public function testParseEventAndServiceCheck(): void {
+
+    $event = Metric::parse('_e{5,4}:title|text');
+    if ($event instanceof Metric) {
+      $this->assertEquals(Metric::TYPE_EVENT, $event->type);
+      $this->assertEquals('title', $event->name);
+    } else {
+      $this->fail('expected an event');
+    }
+
+    $check = Metric::parse('_sc|check|2|#a:b');
+    if ($check instanceof Metric) {
+      $this->assertEquals(Metric::TYPE_SERVICE_CHECK, $check->type);
+      $this->assertEquals('check', $check->name);
+      $this->assertEquals(Vector {'2'}, $check->values);
+      $this->assertEquals(Map {'a' => 'b'}, $check->tags);
+    } else {
+      $this->fail('expected a service check');
+    }
+
+  }
+
+  public function testParseMalformed(): void {
+    $this->assertEquals(null, Metric::parse('no-colon'));
+    $this->assertEquals(null, Metric::parse(':1|c'));
+    $this->assertEquals(null, Metric::parse('a:1'));
+    $this->assertEquals(null, Metric::parse('a:|c'));
+    $this->assertEquals(null, Metric::parse('_e{5,4'));
+    $this->assertEquals(null, Metric::parse('_sc|x'));
+  }
+
+}
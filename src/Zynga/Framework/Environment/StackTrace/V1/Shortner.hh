@@ -5,13 +5,20 @@ namespace Zynga\Framework\Environment\StackTrace\V1;
 use Zynga\Framework\Environment\StackTrace\V1\FrameBuffer;
 
 class Shortner {
+  const int DEFAULT_MAX_FRAMES = 32;
+
+  // Past this many distinct traces intern() stops remembering new ones, they
+  // still get an id but are reported in full every time.
+  const int MAX_INTERNED = 1000;
+
+  private static Map<string, string> $_interned = Map {};
 
   public static function toString(
     int $trimFrames = 0,
     string $delim = "|",
   ): string {
 
-    $frames = debug_backtrace();
+    $frames = debug_backtrace(DEBUG_BACKTRACE_IGNORE_ARGS);
 
     if ($trimFrames > 0) {
       for ($i = 0; $i < $trimFrames; $i++) {
@@ -41,4 +48,96 @@ class Shortner {
 
   }
 
+  /**
+   * The frames debug_backtrace() would return to the caller, without
+   * arguments or objects, minus the first $skipFrames and at most $maxFrames
+   * of them. The engine stops walking the stack at the limit, so a deep stack
+   * costs no more than a shallow one.
+   */
+  public static function capture(
+    int $skipFrames = 0,
+    int $maxFrames = self::DEFAULT_MAX_FRAMES,
+  ): array<array<string, mixed>> {
+
+    $skipFrames = max(0, $skipFrames);
+    $maxFrames = max(1, $maxFrames);
+
+    // +1 for the call into capture() itself.
+    $frames = debug_backtrace(
+      DEBUG_BACKTRACE_IGNORE_ARGS,
+      $skipFrames + $maxFrames + 1,
+    );
+
+    return array_slice($frames, $skipFrames + 1, $maxFrames);
+
+  }
+
+  /**
+   * Formats frames as 'file@line-' per frame, file being the basename.
+   * Frames without a file (internal calls) are left out.
+   */
+  public static function toCompactString(
+    array<array<string, mixed>> $frames,
+  ): string {
+
+    $buffer = '';
+
+    foreach ($frames as $frame) {
+
+      if (array_key_exists('file', $frame) &&
+          array_key_exists('line', $frame)) {
+        $buffer .= basename(strval($frame['file'])).'@'.strval($frame['line']).'-';
+      }
+
+    }
+
+    return $buffer;
+
+  }
+
+  /**
+   * Bounded, args free capture in the compact form, for anything that wants
+   * to know where it was called from without paying for a full trace.
+   */
+  public static function compact(
+    int $skipFrames = 0,
+    int $maxFrames = self::DEFAULT_MAX_FRAMES,
+  ): string {
+    // +1 to step over this function's own frame.
+    return self::toCompactString(self::capture($skipFrames + 1, $maxFrames));
+  }
+
+  /**
+   * Returns a short id for the trace and whether this is the first time it
+   * has been seen, so repeat offenders can report the id alone.
+   */
+  public static function intern(string $trace): (string, bool) {
+
+    $id = substr(md5($trace), 0, 12);
+
+    if (self::$_interned->containsKey($id)) {
+      return tuple($id, false);
+    }
+
+    if (self::$_interned->count() < self::MAX_INTERNED) {
+      self::$_interned->set($id, $trace);
+    }
+
+    return tuple($id, true);
+
+  }
+
+  public static function getInterned(string $id): ?string {
+    return self::$_interned->get($id);
+  }
+
+  public static function getInternedCount(): int {
+    return self::$_interned->count();
+  }
+
+  public static function clearInterned(): bool {
+    self::$_interned->clear();
+    return true;
+  }
+
 }
@@ -23,4 +23,52 @@ class ShortnerTest extends TestCaseBase {
     $this->assertStringStartsWith($stacktrace, Shortner::toString(12));
   }
 
+  public function testCaptureIsBounded(): void {
+
+    $frames = Shortner::capture(0, 2);
+
+    $this->assertEquals(2, count($frames));
+    $this->assertEquals('testCaptureIsBounded', $frames[0]['function']);
+    $this->assertFalse(array_key_exists('args', $frames[0]));
+
+    $skipped = Shortner::capture(1, 1);
+    $this->assertEquals(1, count($skipped));
+    $this->assertEquals($frames[1]['function'], $skipped[0]['function']);
+
+  }
+
+  public function testCompact(): void {
+
+    $trace = Shortner::compact(0, 3);
+
+    $this->assertStringStartsWith('ShortnerTest.hh@', $trace);
+    $this->assertLessThanOrEqual(3, substr_count($trace, '@'));
+
+  }
+
+  public function testIntern(): void {
+
+    Shortner::clearInterned();
+
+    list($id, $isNew) = Shortner::intern('a.hh@1-b.hh@2-');
+    $this->assertEquals(12, strlen($id));
+    $this->assertTrue($isNew);
+
+    list($again, $isNew) = Shortner::intern('a.hh@1-b.hh@2-');
+    $this->assertEquals($id, $again);
+    $this->assertFalse($isNew);
+
+    list($other, $isNew) = Shortner::intern('c.hh@3-');
+    $this->assertNotEquals($id, $other);
+    $this->assertTrue($isNew);
+
+    $this->assertEquals(2, Shortner::getInternedCount());
+    $this->assertEquals('a.hh@1-b.hh@2-', Shortner::getInterned($id));
+    $this->assertEquals(null, Shortner::getInterned('nope'));
+
+    $this->assertTrue(Shortner::clearInterned());
+    $this->assertEquals(0, Shortner::getInternedCount());
+
+  }
+
 }
@@ -2,12 +2,15 @@
 
 namespace Zynga\Framework\Lockable\Cache\V1\Config;
 
+use Zynga\Framework\Environment\StackTrace\V1\Shortner;
 use Zynga\Framework\Lockable\Cache\V1\Interfaces\DriverConfigInterface;
 use Zynga\Framework\Lockable\Cache\V1\Interfaces\LockPayloadInterface;
 use Zynga\Framework\Lockable\Cache\V1\LockPayload;
 use Zynga\Framework\StorableObject\V1\Interfaces\StorableObjectInterface;
 
 abstract class Base implements DriverConfigInterface {
+  // Enough to find the caller, the payload is stored with every lock.
+  const int BACKTRACE_FRAMES = 8;
 
   /**
    *
@@ -21,9 +24,9 @@ abstract class Base implements DriverConfigInterface {
     $payload = new LockPayload();
     $payload->setLockEstablishment(time());
     // --
-    // TODO: add in the backtrace from the caller so we can debug naughty locks.
+    // Where the lock was taken from, so we can debug naughty locks.
     // --
-    $payload->setBacktrace('TODO');
+    $payload->setBacktrace(Shortner::compact(0, self::BACKTRACE_FRAMES));
     return $payload;
   }
 
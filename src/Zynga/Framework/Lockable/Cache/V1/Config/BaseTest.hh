@@ -15,7 +15,7 @@ class BaseTest extends TestCase {
 
     $this->assertInstanceOf(LockPayloadInterface::class, $payload);
     $this->assertGreaterThan(0, $payload->getLockEstablishment());
-    $this->assertEquals('TODO', $payload->getBacktrace());
+    $this->assertStringStartsWith('BaseTest.hh@', $payload->getBacktrace());
 
   }
 
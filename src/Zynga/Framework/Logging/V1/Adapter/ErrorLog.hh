@@ -3,14 +3,49 @@
 namespace Zynga\Framework\Logging\V1\Adapter;
 
 use Zynga\Framework\Logging\V1\Adapter\Base as AdapterBase;
+use Zynga\Framework\Logging\V1\Interfaces\BatchLoggerAdapterInterface;
 use Zynga\Framework\Logging\V1\Level;
+use Zynga\Framework\Logging\V1\LogEntry;
 
-class ErrorLog extends AdapterBase {
+class ErrorLog extends AdapterBase implements BatchLoggerAdapterInterface {
 
   public function writeLogEntry(int $level, string $message, Map<string, mixed> $data): bool {
 
+    error_log($this->formatLogEntry($level, $message, $data, microtime(true)));
+
+    return true;
+
+  }
+
+  public function writeLogEntries(Vector<LogEntry> $entries): bool {
+
+    if ( $entries->count() == 0 ) {
+      return true;
+    }
+
+    $lines = Vector {};
+
+    foreach ( $entries as $entry ) {
+      $lines->add(
+        $this->formatLogEntry(
+          $entry->getLevel(),
+          $entry->getMessage(),
+          $entry->getData(),
+          $entry->getTime(),
+        ),
+      );
+    }
+
+    // One write for the lot, the lines land together and in order.
+    error_log(implode("\n", $lines));
+
+    return true;
+
+  }
+
+  public function formatLogEntry(int $level, string $message, Map<string, mixed> $data, float $t): string {
+
     // Pull the timer in, and pretty print it
-    $t     = microtime(true);
     $micro = sprintf("%06d",($t - floor($t)) * 1000000);
     $now   = date('Y-m-d\TH:i:s', $t) . '.' . $micro;
 
@@ -37,9 +72,7 @@ class ErrorLog extends AdapterBase {
 
     }
 
-    error_log($logEntry);
-
-    return true;
+    return $logEntry;
 
   }
 
@@ -0,0 +1,48 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1\Adapter;
+
+use Zynga\Framework\Logging\V1\Adapter\Base as AdapterBase;
+use Zynga\Framework\Logging\V1\Interfaces\BatchLoggerAdapterInterface;
+use Zynga\Framework\Logging\V1\LogEntry;
+
+/**
+ * Keeps entries in memory and counts the writes that delivered them, for
+ * tests that need to see what a driver wrote and how.
+ */
+class Memory extends AdapterBase implements BatchLoggerAdapterInterface {
+  private Vector<LogEntry> $_entries;
+  private int $_writeCount;
+
+  public function __construct() {
+    $this->_entries = Vector {};
+    $this->_writeCount = 0;
+  }
+
+  public function writeLogEntry(int $level, string $message, Map<string, mixed> $data): bool {
+    $this->_entries->add(new LogEntry($level, $message, $data, microtime(true)));
+    $this->_writeCount++;
+    return true;
+  }
+
+  public function writeLogEntries(Vector<LogEntry> $entries): bool {
+    $this->_entries->addAll($entries);
+    $this->_writeCount++;
+    return true;
+  }
+
+  public function getEntries(): Vector<LogEntry> {
+    return $this->_entries;
+  }
+
+  public function getWriteCount(): int {
+    return $this->_writeCount;
+  }
+
+  public function clear(): bool {
+    $this->_entries->clear();
+    $this->_writeCount = 0;
+    return true;
+  }
+
+}
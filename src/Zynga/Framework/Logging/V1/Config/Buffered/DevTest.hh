@@ -0,0 +1,14 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1\Config\Buffered;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+use Zynga\Framework\Logging\V1\Config\Buffered\Dev as ConfigUnderTest;
+
+class DevTest extends TestCase {
+  public function testConfig(): void {
+    $obj = new ConfigUnderTest();
+    $this->assertTrue($obj->init());
+    $this->assertEquals('Buffered', $obj->getDriver());
+  }
+}
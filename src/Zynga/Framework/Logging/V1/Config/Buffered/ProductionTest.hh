@@ -0,0 +1,16 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1\Config\Buffered;
+
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+use
+  Zynga\Framework\Logging\V1\Config\Buffered\Production as ConfigUnderTest
+;
+
+class ProductionTest extends TestCase {
+  public function testConfig(): void {
+    $obj = new ConfigUnderTest();
+    $this->assertTrue($obj->init());
+    $this->assertEquals('Buffered', $obj->getDriver());
+  }
+}
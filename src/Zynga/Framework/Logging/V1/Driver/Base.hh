@@ -2,6 +2,7 @@
 
 namespace Zynga\Framework\Logging\V1\Driver;
 
+use Zynga\Framework\Environment\StackTrace\V1\Shortner;
 use Zynga\Framework\Logging\V1\Interfaces\LoggerInterface;
 use Zynga\Framework\Logging\V1\Interfaces\LoggerConfigInterface;
 use Zynga\Framework\Logging\V1\Interfaces\LoggerAdapterInterface;
@@ -12,10 +13,14 @@ use \Exception;
 abstract class Base implements LoggerInterface, LoggerAdapterInterface {
   private LoggerConfigInterface $_config;
   private bool $_hideAllLogs;
+  private int $_backtraceFrames;
+  private bool $_internBacktraces;
 
   public function __construct(LoggerConfigInterface $config) {
     $this->_config = $config;
     $this->_hideAllLogs = false;
+    $this->_backtraceFrames = Shortner::DEFAULT_MAX_FRAMES;
+    $this->_internBacktraces = false;
   }
 
   public function getConfig(): LoggerConfigInterface {
@@ -27,6 +32,41 @@ abstract class Base implements LoggerInterface, LoggerAdapterInterface {
     return true;
   }
 
+  /**
+   * Caps how many frames an includeBacktrace entry walks and formats.
+   */
+  public function setBacktraceFrames(int $frames): bool {
+    $this->_backtraceFrames = max(1, $frames);
+    return true;
+  }
+
+  public function getBacktraceFrames(): int {
+    return $this->_backtraceFrames;
+  }
+
+  /**
+   * With interning on every backtrace entry carries a short backtraceId, and
+   * the full backtrace is only written the first time that id is seen.
+   */
+  public function setInternBacktraces(bool $intern): bool {
+    $this->_internBacktraces = $intern;
+    return true;
+  }
+
+  public function getInternBacktraces(): bool {
+    return $this->_internBacktraces;
+  }
+
+  public function isLevelEnabled(int $level): bool {
+
+    if ($this->_hideAllLogs === true) {
+      return false;
+    }
+
+    return $this->_config->shouldLog($level);
+
+  }
+
   public function exception(
     string $message,
     Map<string, mixed> $data,
@@ -112,20 +152,10 @@ abstract class Base implements LoggerInterface, LoggerAdapterInterface {
   }
 
   public function formatBacktrace(mixed $bt): string {
-    $logString = '';
     if (!is_array($bt)) {
-      return $logString;
-    }
-    foreach ($bt as $number => $data) {
-      if (array_key_exists('file', $data) &&
-          array_key_exists('line', $data)) {
-        $file = $data['file'];
-        $line = $data['line'];
-        $fileName = substr($file, strrpos($file, '/', -1) + 1, strlen($file));
-        $logString = $logString.$fileName.'@'.$line."-";
-      }
+      return '';
     }
-    return $logString;
+    return Shortner::toCompactString($bt);
   }
 
   private function _recordLogEntry(
@@ -136,27 +166,48 @@ abstract class Base implements LoggerInterface, LoggerAdapterInterface {
     float $sampleRate = 100.0,
   ): bool {
 
-    if ((mt_rand() / mt_getrandmax()) * 100.0 > $sampleRate) {
+    // Cheapest checks first, a disabled level never pays for mt_rand().
+    if ($this->isLevelEnabled($level) !== true) {
       return false;
     }
 
-    if ($this->_hideAllLogs === true) {
-      return false;
-    }
-
-    if ($this->_config->shouldLog($level) !== true) {
+    if ($sampleRate < 100.0 &&
+        (mt_rand() / mt_getrandmax()) * 100.0 > $sampleRate) {
       return false;
     }
 
     if ($includeBacktrace === true &&
         $data->containsKey('backtrace') !== true) {
-      $data['backtrace'] = $this->formatBacktrace(debug_backtrace());
+      $this->addBacktrace($data);
     }
 
     return $this->writeLogEntry($level, $message, $data);
 
   }
 
+  private function addBacktrace(Map<string, mixed> $data): void {
+
+    // Skip addBacktrace() itself, the trace starts at the call into
+    // _recordLogEntry() as it always has.
+    $trace = Shortner::toCompactString(
+      Shortner::capture(1, $this->_backtraceFrames),
+    );
+
+    if ($this->_internBacktraces !== true) {
+      $data['backtrace'] = $trace;
+      return;
+    }
+
+    list($id, $isNew) = Shortner::intern($trace);
+
+    $data['backtraceId'] = $id;
+
+    if ($isNew === true) {
+      $data['backtrace'] = $trace;
+    }
+
+  }
+
   abstract public function writeLogEntry(
     int $level,
     string $message,
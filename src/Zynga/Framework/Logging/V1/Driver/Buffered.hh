@@ -0,0 +1,218 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1\Driver;
+
+use Zynga\Framework\Logging\V1\Driver\Base as DriverBase;
+use Zynga\Framework\Logging\V1\Interfaces\BatchLoggerAdapterInterface;
+use Zynga\Framework\Logging\V1\Interfaces\LoggerConfigInterface;
+use Zynga\Framework\Logging\V1\Level;
+use Zynga\Framework\Logging\V1\LogEntry;
+
+/**
+ * Holds entries in memory and hands them to the configured adapters in one
+ * go, when the buffer reaches its entry or byte cap, when an entry at or
+ * above the flush level arrives, and at shutdown.
+ *
+ * Entries keep the order they were logged in and the time they were logged
+ * at. If the request dies on a fatal error the shutdown flush adds the
+ * fatal itself as a CRITICAL entry after everything that led up to it.
+ */
+class Buffered extends DriverBase {
+  const int DEFAULT_MAX_ENTRIES = 100;
+  const int DEFAULT_MAX_BYTES = 65536;
+  const int FATAL_ERRORS =
+    E_ERROR | E_PARSE | E_CORE_ERROR | E_COMPILE_ERROR | E_USER_ERROR;
+
+  // Buffers holding entries, flushed by the one shutdown function. A buffer
+  // leaves the table when it flushes so it can still be destructed early.
+  private static Map<string, Buffered> $_pending = Map {};
+  private static bool $_isShutdownRegistered = false;
+
+  private Vector<LogEntry> $_entries;
+  private int $_bytes;
+  private int $_maxEntries;
+  private int $_maxBytes;
+  private int $_flushLevel;
+  private int $_flushCount;
+
+  public function __construct(LoggerConfigInterface $config) {
+
+    parent::__construct($config);
+
+    $this->_entries = Vector {};
+    $this->_bytes = 0;
+    $this->_maxEntries = self::DEFAULT_MAX_ENTRIES;
+    $this->_maxBytes = self::DEFAULT_MAX_BYTES;
+    $this->_flushLevel = Level::CRITICAL;
+    $this->_flushCount = 0;
+
+  }
+
+  public function __destruct() {
+    $this->flush();
+  }
+
+  public function setMaxEntries(int $maxEntries): bool {
+    $this->_maxEntries = max(1, $maxEntries);
+    return true;
+  }
+
+  public function getMaxEntries(): int {
+    return $this->_maxEntries;
+  }
+
+  public function setMaxBytes(int $maxBytes): bool {
+    $this->_maxBytes = max(1, $maxBytes);
+    return true;
+  }
+
+  public function getMaxBytes(): int {
+    return $this->_maxBytes;
+  }
+
+  /**
+   * Entries at or above this level flush the buffer straight away, so what
+   * led up to them is on disk before anything else can go wrong.
+   */
+  public function setFlushLevel(int $level): bool {
+    $this->_flushLevel = $level;
+    return true;
+  }
+
+  public function getFlushLevel(): int {
+    return $this->_flushLevel;
+  }
+
+  public function getBufferedCount(): int {
+    return $this->_entries->count();
+  }
+
+  public function getBufferedBytes(): int {
+    return $this->_bytes;
+  }
+
+  public function getFlushCount(): int {
+    return $this->_flushCount;
+  }
+
+  public function writeLogEntry(int $level, string $message, Map<string, mixed> $data): bool {
+
+    $this->_entries->add(new LogEntry($level, $message, $data, microtime(true)));
+    $this->_bytes += self::estimateBytes($message, $data);
+    $this->markPending();
+
+    if ( $level >= $this->_flushLevel ||
+         $this->_entries->count() >= $this->_maxEntries ||
+         $this->_bytes >= $this->_maxBytes ) {
+      $this->flush();
+    }
+
+    return true;
+
+  }
+
+  /**
+   * Writes the buffered entries to every adapter, in one batch where the
+   * adapter supports it, one entry at a time in order where it does not.
+   */
+  public function flush(): bool {
+
+    if ( $this->_entries->count() == 0 ) {
+      return false;
+    }
+
+    $entries = $this->_entries;
+
+    self::$_pending->removeKey(spl_object_hash($this));
+
+    $this->_entries = Vector {};
+    $this->_bytes = 0;
+    $this->_flushCount++;
+
+    foreach ( $this->getConfig()->getAdapters() as $adapter ) {
+
+      if ( $adapter instanceof BatchLoggerAdapterInterface ) {
+        $adapter->writeLogEntries($entries);
+        continue;
+      }
+
+      foreach ( $entries as $entry ) {
+        $adapter->writeLogEntry($entry->getLevel(), $entry->getMessage(), $entry->getData());
+      }
+
+    }
+
+    return true;
+
+  }
+
+  public function flushOnShutdown(): bool {
+
+    $error = error_get_last();
+
+    if ( is_array($error) && (intval($error['type']) & self::FATAL_ERRORS) != 0 ) {
+      $this->_entries->add(
+        new LogEntry(
+          Level::CRITICAL,
+          'Fatal error at shutdown',
+          Map {
+            'errorType' => $error['type'],
+            'errorMessage' => $error['message'],
+            'errorFile' => $error['file'],
+            'errorLine' => $error['line'],
+          },
+          microtime(true),
+        ),
+      );
+    }
+
+    return $this->flush();
+
+  }
+
+  /**
+   * Runs once at shutdown for every buffer that still holds entries.
+   */
+  public static function flushAllOnShutdown(): bool {
+
+    $flushed = false;
+
+    foreach ( self::$_pending->toVector() as $buffer ) {
+      if ( $buffer->flushOnShutdown() === true ) {
+        $flushed = true;
+      }
+    }
+
+    return $flushed;
+
+  }
+
+  private function markPending(): void {
+
+    self::$_pending->set(spl_object_hash($this), $this);
+
+    if ( self::$_isShutdownRegistered === true ) {
+      return;
+    }
+
+    self::$_isShutdownRegistered = true;
+
+    register_shutdown_function(() ==> {
+      self::flushAllOnShutdown();
+    });
+
+  }
+
+  private static function estimateBytes(string $message, Map<string, mixed> $data): int {
+
+    $bytes = strlen($message);
+
+    foreach ( $data as $key => $value ) {
+      $bytes += strlen($key) + (is_string($value) ? strlen($value) : 16);
+    }
+
+    return $bytes;
+
+  }
+
+}
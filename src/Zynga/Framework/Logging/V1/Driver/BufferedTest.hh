@@ -0,0 +1,171 @@
+<?hh //strict
+
+namespace Zynga\Framework\Logging\V1\Driver;
+
+use Zynga\Framework\Environment\StackTrace\V1\Shortner;
+use Zynga\Framework\Logging\V1\Adapter\Memory;
+use Zynga\Framework\Logging\V1\Config\Noop\Dev as NoopConfig;
+use Zynga\Framework\Logging\V1\Driver\Buffered;
+use Zynga\Framework\Logging\V1\Level;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class BufferedTest extends TestCase {
+
+  private function createLogger(Memory $memory): Buffered {
+    $config = new NoopConfig();
+    $config->addAdapter($memory);
+    return new Buffered($config);
+  }
+
+  public function testBuffersUntilFlush(): void {
+
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+
+    $this->assertTrue($logger->info('first', Map {}));
+    $this->assertTrue($logger->warning('second', Map {'a' => 'b'}));
+
+    $this->assertEquals(2, $logger->getBufferedCount());
+    $this->assertGreaterThan(0, $logger->getBufferedBytes());
+    $this->assertEquals(0, $memory->getEntries()->count());
+
+    $this->assertTrue($logger->flush());
+    $this->assertFalse($logger->flush());
+
+    $this->assertEquals(0, $logger->getBufferedCount());
+    $this->assertEquals(0, $logger->getBufferedBytes());
+    $this->assertEquals(1, $logger->getFlushCount());
+
+    // One write, in the order logged.
+    $this->assertEquals(1, $memory->getWriteCount());
+    $entries = $memory->getEntries();
+    $this->assertEquals('first', $entries[0]->getMessage());
+    $this->assertEquals(Level::INFO, $entries[0]->getLevel());
+    $this->assertEquals('second', $entries[1]->getMessage());
+    $this->assertEquals(Map {'a' => 'b'}, $entries[1]->getData());
+    $this->assertLessThanOrEqual(
+      $entries[1]->getTime(),
+      $entries[0]->getTime(),
+    );
+
+  }
+
+  public function testFlushesAtMaxEntries(): void {
+
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+    $this->assertTrue($logger->setMaxEntries(3));
+    $this->assertEquals(3, $logger->getMaxEntries());
+
+    $logger->debug('1', Map {});
+    $logger->debug('2', Map {});
+    $this->assertEquals(0, $memory->getEntries()->count());
+
+    $logger->debug('3', Map {});
+    $this->assertEquals(3, $memory->getEntries()->count());
+    $this->assertEquals(0, $logger->getBufferedCount());
+
+  }
+
+  public function testFlushesAtMaxBytes(): void {
+
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+    $this->assertTrue($logger->setMaxBytes(20));
+    $this->assertEquals(20, $logger->getMaxBytes());
+
+    $logger->info('0123456789', Map {});
+    $this->assertEquals(1, $logger->getBufferedCount());
+
+    $logger->info('0123456789', Map {});
+    $this->assertEquals(0, $logger->getBufferedCount());
+    $this->assertEquals(2, $memory->getEntries()->count());
+
+  }
+
+  public function testFlushLevel(): void {
+
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+    $this->assertEquals(Level::CRITICAL, $logger->getFlushLevel());
+
+    $logger->info('context', Map {});
+    $logger->critical('boom', Map {}, false);
+
+    $this->assertEquals(2, $memory->getEntries()->count());
+    $this->assertEquals('boom', $memory->getEntries()[1]->getMessage());
+
+    $this->assertTrue($logger->setFlushLevel(Level::WARNING));
+    $logger->warning('careful', Map {});
+    $this->assertEquals(3, $memory->getEntries()->count());
+
+  }
+
+  public function testHiddenLogsAreNotBuffered(): void {
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+    $logger->setHideAllLogs(true);
+    $this->assertFalse($logger->info('hidden', Map {}));
+    $this->assertEquals(0, $logger->getBufferedCount());
+  }
+
+  public function testShutdownFlush(): void {
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+    $logger->info('pending', Map {});
+    $this->assertTrue($logger->flushOnShutdown());
+    $this->assertEquals('pending', $memory->getEntries()[0]->getMessage());
+  }
+
+  public function testShutdownFlushesEveryPendingBuffer(): void {
+    $first = new Memory();
+    $second = new Memory();
+    $this->createLogger($first)->info('first', Map {});
+    $this->createLogger($second)->info('second', Map {});
+    $this->assertTrue(Buffered::flushAllOnShutdown());
+    $this->assertEquals('first', $first->getEntries()[0]->getMessage());
+    $this->assertEquals('second', $second->getEntries()[0]->getMessage());
+    // Flushed buffers leave the table, nothing is left for a second pass.
+    $this->assertFalse(Buffered::flushAllOnShutdown());
+  }
+
+  public function testBoundedInternedBacktraces(): void {
+
+    Shortner::clearInterned();
+
+    $memory = new Memory();
+    $logger = $this->createLogger($memory);
+
+    $this->assertEquals(Shortner::DEFAULT_MAX_FRAMES, $logger->getBacktraceFrames());
+    $this->assertFalse($logger->getInternBacktraces());
+
+    $this->assertTrue($logger->setBacktraceFrames(2));
+    $this->assertTrue($logger->setInternBacktraces(true));
+
+    for ($i = 0; $i < 3; $i++) {
+      $logger->error('same place', Map {});
+    }
+
+    $this->assertTrue($logger->flush());
+
+    $entries = $memory->getEntries();
+    $this->assertEquals(3, $entries->count());
+
+    // The first one carries the trace, the repeats only its id.
+    $first = $entries[0]->getData();
+    $trace = strval($first['backtrace']);
+    $this->assertStringStartsWith('Base.hh@', $trace);
+    $this->assertEquals(2, substr_count($trace, '@'));
+    $this->assertEquals($trace, Shortner::getInterned(strval($first['backtraceId'])));
+
+    for ($i = 1; $i < 3; $i++) {
+      $data = $entries[$i]->getData();
+      $this->assertFalse($data->containsKey('backtrace'));
+      $this->assertEquals($first['backtraceId'], $data['backtraceId']);
+    }
+
+    Shortner::clearInterned();
+
+  }
+
+}
@@ -0,0 +1,17 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1\Interfaces;
+
+use Zynga\Framework\Logging\V1\Interfaces\LoggerAdapterInterface;
+use Zynga\Framework\Logging\V1\LogEntry;
+
+interface BatchLoggerAdapterInterface extends LoggerAdapterInterface {
+
+  /**
+   * Writes a run of entries, in order, in as few writes as the adapter can.
+   * @param Vector<LogEntry>
+   * @return bool
+   */
+  public function writeLogEntries(Vector<LogEntry> $entries): bool;
+
+}
@@ -10,6 +10,7 @@ interface LoggerInterface extends BaseDriverInterface {
 
   public function getConfig(): LoggerConfigInterface;
   public function setHideAllLogs(bool $logState): bool;
+  public function isLevelEnabled(int $level): bool;
   public function exception(string $message, Map<string, mixed> $data, Exception $exception, bool $includeBacktrace = true): bool;
   public function critical(string $message, Map<string, mixed> $data, bool $includeBacktrace = true): bool;
   public function error(string $message, Map<string, mixed> $data, bool $includeBacktrace = true, float $sampleRate = 100.0): bool;
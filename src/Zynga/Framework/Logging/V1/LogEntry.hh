@@ -0,0 +1,38 @@
+<?hh // strict
+
+namespace Zynga\Framework\Logging\V1;
+
+/**
+ * A log entry captured for a later write, stamped with the time it was
+ * logged rather than the time it is written.
+ */
+class LogEntry {
+  private int $_level;
+  private string $_message;
+  private Map<string, mixed> $_data;
+  private float $_time;
+
+  public function __construct(int $level, string $message, Map<string, mixed> $data, float $time) {
+    $this->_level = $level;
+    $this->_message = $message;
+    $this->_data = $data;
+    $this->_time = $time;
+  }
+
+  public function getLevel(): int {
+    return $this->_level;
+  }
+
+  public function getMessage(): string {
+    return $this->_message;
+  }
+
+  public function getData(): Map<string, mixed> {
+    return $this->_data;
+  }
+
+  public function getTime(): float {
+    return $this->_time;
+  }
+
+}
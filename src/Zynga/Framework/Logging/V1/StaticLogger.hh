@@ -4,6 +4,7 @@ namespace Zynga\Framework\Logging\V1;
 
 use Zynga\Framework\Logging\V1\Factory as LogFactory;
 use Zynga\Framework\Logging\V1\Interfaces\LoggerInterface;
+use Zynga\Framework\Logging\V1\Level;
 use \Exception;
 
 class StaticLogger {
@@ -43,4 +44,48 @@ class StaticLogger {
     return $logger->debug($message, $data, $includeBacktrace);
   }
 
+  public static function isLevelEnabled(int $level, string $context = 'default'): bool {
+    $logger = LogFactory::factory(LoggerInterface::class, $context);
+    return $logger->isLevelEnabled($level);
+  }
+
+  /**
+   * Logs at $level with the message and data returned by $producer, which is
+   * only called if the level is enabled. Use it where building the payload
+   * costs more than the log call, debug dumps in hot paths especially.
+   *
+   * StaticLogger::debugLazy(() ==> tuple('cache miss', Map {'key' => $key}));
+   */
+  public static function lazy(int $level, (function(): (string, Map<string, mixed>)) $producer, bool $includeBacktrace = false, string $context = 'default'): bool {
+
+    $logger = LogFactory::factory(LoggerInterface::class, $context);
+
+    if ( $logger->isLevelEnabled($level) !== true ) {
+      return false;
+    }
+
+    list($message, $data) = $producer();
+
+    if ( $level === Level::CRITICAL ) {
+      return $logger->critical($message, $data, $includeBacktrace);
+    } else if ( $level === Level::ERROR ) {
+      return $logger->error($message, $data, $includeBacktrace);
+    } else if ( $level === Level::WARNING ) {
+      return $logger->warning($message, $data, $includeBacktrace);
+    } else if ( $level === Level::INFO ) {
+      return $logger->info($message, $data, $includeBacktrace);
+    }
+
+    return $logger->debug($message, $data, $includeBacktrace);
+
+  }
+
+  public static function debugLazy((function(): (string, Map<string, mixed>)) $producer, bool $includeBacktrace = false, string $context = 'default'): bool {
+    return self::lazy(Level::DEBUG, $producer, $includeBacktrace, $context);
+  }
+
+  public static function infoLazy((function(): (string, Map<string, mixed>)) $producer, bool $includeBacktrace = false, string $context = 'default'): bool {
+    return self::lazy(Level::INFO, $producer, $includeBacktrace, $context);
+  }
+
 }
@@ -4,6 +4,7 @@ namespace Zynga\Framework\Logging\V1;
 
 use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
 
+use Zynga\Framework\Logging\V1\Level;
 use Zynga\Framework\Logging\V1\StaticLogger;
 
 class StaticLoggerTest extends TestCase {
@@ -18,4 +19,28 @@ class StaticLoggerTest extends TestCase {
     $this->assertTrue(StaticLogger::critical('CRITICAL - I am', Map {}, true, self::CONTEXT));
   }
 
+  public function test_lazy(): void {
+
+    $calls = Vector {};
+    $producer = () ==> {
+      $calls->add(true);
+      return tuple('LAZY - I am', Map {'calls' => $calls->count()});
+    };
+
+    // Nothing enabled, the payload is never built.
+    $this->assertFalse(StaticLogger::isLevelEnabled(Level::DEBUG, 'NoLevelsSet'));
+    $this->assertFalse(StaticLogger::debugLazy($producer, false, 'NoLevelsSet'));
+    $this->assertFalse(StaticLogger::lazy(Level::CRITICAL, $producer, false, 'NoLevelsSet'));
+    $this->assertEquals(0, $calls->count());
+
+    $this->assertTrue(StaticLogger::isLevelEnabled(Level::DEBUG, self::CONTEXT));
+    $this->assertTrue(StaticLogger::debugLazy($producer, false, self::CONTEXT));
+    $this->assertTrue(StaticLogger::infoLazy($producer, false, self::CONTEXT));
+    $this->assertTrue(StaticLogger::lazy(Level::WARNING, $producer, false, self::CONTEXT));
+    $this->assertTrue(StaticLogger::lazy(Level::ERROR, $producer, false, self::CONTEXT));
+    $this->assertTrue(StaticLogger::lazy(Level::CRITICAL, $producer, false, self::CONTEXT));
+    $this->assertEquals(5, $calls->count());
+
+  }
+
 }
@@ -0,0 +1,7 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\Exceptions;
+
+use Zynga\Framework\Exception\V1\Exception;
+
+class VersionConflictException extends Exception {}
@@ -13,14 +13,20 @@ interface CacheInterface {
   public function getResultSetCache(): LockableDriverInterface;
   public function lockRowCache(PgRowInterface $row): bool;
   public function unlockRowCache(PgRowInterface $row): bool;
+  public function invalidateRowCache(PgRowInterface $row): bool;
+  public function getProjectedRow(PgRowInterface $row): bool;
+  public function setProjectedRow(PgRowInterface $row): bool;
+  public function invalidateProjectedRows(PgRowInterface $row): bool;
   
   public function lockResultSetCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
+    ?Vector<string> $fields = null,
   ): bool;
   
   public function unlockResultSetCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
+    ?Vector<string> $fields = null,
   ): bool;
 }
@@ -7,5 +7,17 @@ use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
 interface DbInterface {
   public function getReadDatabase(): QueryableInterface;
   public function getWriteDatabase(): QueryableInterface;
+
+  /**
+   * Hands a handle from getReadDatabase() back once the query is complete, so
+   * read routing can track outstanding queries per replica.
+   */
+  public function releaseReadDatabase(QueryableInterface $dbh): bool;
+
+  /**
+   * Keeps reads on the primary for the rest of the request, called after a
+   * write so the caller can read what it just wrote.
+   */
+  public function pinReadsToPrimary(): bool;
   public function quoteValue(QueryableInterface $dbh, mixed $value): string;
 }
@@ -15,13 +15,20 @@ interface ReaderInterface {
     bool $getLocked
   ): ?PgRowInterface;
   
+  public function getByPks<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    Vector<mixed> $ids,
+  ): Map<string, PgRowInterface>;
+
   public function get<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     ?PgWhereClauseInterface $where = null,
+    ?Vector<string> $fields = null,
   ): PgResultSetInterface<PgRowInterface>;
   
   public function createCachedResultSet<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $pgWhere,
+    ?Vector<string> $fields = null,
   ): PgCachedResultSet<TypeInterface>;
 }
@@ -7,5 +7,9 @@ use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
 interface WriterInterface {
   public function add(PgRowInterface $row, bool $shouldUnlock): bool;
   public function save(PgRowInterface $row, bool $shouldUnlock): bool;
+  public function saveAll(
+    Traversable<PgRowInterface> $rows,
+    bool $shouldUnlock,
+  ): bool;
   public function delete(PgRowInterface $obj, bool $shouldUnlock): bool;
 }
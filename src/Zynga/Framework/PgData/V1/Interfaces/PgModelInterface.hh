@@ -9,10 +9,15 @@ use Zynga\Framework\PgData\V1\Interfaces\PgModel\ReaderInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\StatsInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\WriterInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRoutingStrategy;
 
 interface PgModelInterface {
 
   public function add(PgRowInterface $row, bool $shouldUnlock = true): bool;
+  public function saveAll(
+    Traversable<PgRowInterface> $rows,
+    bool $shouldUnlock = true,
+  ): bool;
   public function cache(): CacheInterface;
   public function data(): DataInterface;
   public function db(): DbInterface;
@@ -20,6 +25,10 @@ interface PgModelInterface {
   public function getResultSetCacheName(): string;
   public function getReadDatabaseName(): string;
   public function getWriteDatabaseName(): string;
+  public function getReadReplicaDatabaseNames(): Map<string, int>;
+  public function getReadRoutingStrategy(): ReadRoutingStrategy;
+  public function getMaxReplicationLagSeconds(): int;
+  public function getReplicationLagSql(): string;
   public function reader(): ReaderInterface;
   public function stats(): StatsInterface;
   public function writer(): WriterInterface;
@@ -28,8 +37,13 @@ interface PgModelInterface {
     mixed $id,
     bool $shouldLock
   ): ?PgRowInterface;
+  public function getByPks<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    Vector<mixed> $ids,
+  ): Map<string, PgRowInterface>;
   public function get<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     ?PgWhereClauseInterface $where = null,
+    ?Vector<string> $fields = null,
   ): PgResultSetInterface<PgRowInterface>;
 }
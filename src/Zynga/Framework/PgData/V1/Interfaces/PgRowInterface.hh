@@ -12,6 +12,13 @@ interface PgRowInterface extends StorableObjectInterface {
   public function getPrimaryKey(): string;
   public function getPrimaryKeyTyped(): TypeInterface;
   public function getTableName(): string;
+  public function getProjection(): ?Vector<string>;
+  public function setProjection(?Vector<string> $fields): bool;
+  public function getProjectionChecksum(): string;
+  public function isReadOnly(): bool;
+  public function setIsReadOnly(bool $isReadOnly): bool;
+  public function getVersionField(): string;
+  public function getVersion(): int;
   public function save(bool $shouldUnlock = true): bool;
   public function delete(bool $shouldUnlock = true): bool;
 }
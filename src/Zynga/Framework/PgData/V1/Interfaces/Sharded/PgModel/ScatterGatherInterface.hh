@@ -0,0 +1,34 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\Interfaces\Sharded\PgModel;
+
+use Zynga\Framework\PgData\V1\Interfaces\PgResultSetInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgWhereClauseInterface;
+
+interface ScatterGatherInterface {
+
+  public function get<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    ?PgWhereClauseInterface $where = null,
+    ?Vector<int> $shardIndexes = null,
+    string $orderBy = '',
+    bool $orderAscending = true,
+    int $limit = 0,
+  ): PgResultSetInterface<PgRowInterface>;
+
+  public function genGet<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    ?PgWhereClauseInterface $where = null,
+    ?Vector<int> $shardIndexes = null,
+    string $orderBy = '',
+    bool $orderAscending = true,
+    int $limit = 0,
+  ): Awaitable<PgResultSetInterface<PgRowInterface>>;
+
+  public function getShardLatencies(): Map<int, float>;
+
+  public function getTimeoutMicros(): int;
+  public function setTimeoutMicros(int $timeoutMicros): bool;
+
+}
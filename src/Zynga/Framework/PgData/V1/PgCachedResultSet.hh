@@ -14,10 +14,12 @@ class PgCachedResultSet<Tv as TypeInterface> extends Base<Tv> {
   private PgWhereClauseInterface $_where;
   private classname<Tv> $_rawType;
   private string $_checksum;
+  private string $_projectionChecksum;
 
   public function __construct(
     classname<Tv> $rawType,
     PgWhereClauseInterface $where,
+    string $projectionChecksum = '',
   ) {
 
     parent::__construct($rawType);
@@ -25,6 +27,7 @@ class PgCachedResultSet<Tv as TypeInterface> extends Base<Tv> {
     $this->_where = $where;
     $this->_rawType = $rawType;
     $this->_checksum = '';
+    $this->_projectionChecksum = $projectionChecksum;
 
   }
 
@@ -38,7 +41,8 @@ class PgCachedResultSet<Tv as TypeInterface> extends Base<Tv> {
     $typeChecksum = md5($this->_rawType);
     $whereChecksum = $this->_where->createWhereChecksum();
 
-    $this->_checksum = $typeChecksum.'|'.$whereChecksum;
+    $this->_checksum =
+      $typeChecksum.'|'.$whereChecksum.$this->_projectionChecksum;
 
     return $this->_checksum;
 
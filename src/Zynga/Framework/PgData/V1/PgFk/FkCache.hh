@@ -5,10 +5,22 @@ namespace Zynga\Framework\PgData\V1\PgFk;
 use Zynga\Framework\Dynamic\V1\DynamicClassCreation;
 use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgResultSetInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
+use Zynga\Framework\PgData\V1\PgFk;
 
+/**
+ * Process level cache of resolved foreign keys.
+ *
+ * The cache is bounded and evicts in least recently used order, so long running
+ * daemons do not grow without limit. Map keeps insertion order, so a hit is
+ * moved to the tail and eviction always pops the head.
+ */
 class FkCache<TModel as PgModelInterface, TRow as PgRowInterface> {
+  const int DEFAULT_MAX_ENTRIES = 10000;
+
   private static Map<string, ?PgRowInterface> $_cache = Map {};
+  private static int $_maxEntries = self::DEFAULT_MAX_ENTRIES;
 
   public static function getFk(
     classname<TModel> $fkModel,
@@ -19,8 +31,8 @@ class FkCache<TModel as PgModelInterface, TRow as PgRowInterface> {
     $cacheKey = self::createCacheKey($fkModel, $fkRow, $fkId);
 
     // have we have done a resolve before? if so return the cached results.
-    if (self::$_cache->at($cacheKey)) {
-      return self::$_cache->get($cacheKey);
+    if (self::$_cache->containsKey($cacheKey)) {
+      return self::touch($cacheKey);
     }
 
     // do a resolve on
@@ -30,7 +42,7 @@ class FkCache<TModel as PgModelInterface, TRow as PgRowInterface> {
 
       if ($model instanceof PgModelInterface) {
         $actualFkRow = $model->getByPk($fkRow, $fkId, false);
-        self::$_cache->set($cacheKey, $actualFkRow);
+        self::store($cacheKey, $actualFkRow);
         return $actualFkRow;
       }
 
@@ -42,6 +54,138 @@ class FkCache<TModel as PgModelInterface, TRow as PgRowInterface> {
 
   }
 
+  /**
+   * Resolves all of the given ids with a single batched fetch, ids that are
+   * already cached are skipped. Ids that do not resolve are cached as null so a
+   * later getFk() does not go back to the database for them.
+   *
+   * @return int number of ids that needed resolving
+   */
+  public static function prefetch(
+    classname<TModel> $fkModel,
+    classname<TRow> $fkRow,
+    Vector<mixed> $fkIds,
+  ): int {
+
+    try {
+
+      $missingIds = Vector {};
+      $missingKeys = Map {};
+
+      foreach ($fkIds as $fkId) {
+
+        $cacheKey = self::createCacheKey($fkModel, $fkRow, $fkId);
+
+        if (self::$_cache->containsKey($cacheKey) ||
+            $missingKeys->containsKey($cacheKey)) {
+          continue;
+        }
+
+        $missingKeys->set($cacheKey, strval($fkId));
+        $missingIds->add($fkId);
+
+      }
+
+      if ($missingIds->count() == 0) {
+        return 0;
+      }
+
+      $model = DynamicClassCreation::createClassByName($fkModel, Vector {});
+
+      if (!$model instanceof PgModelInterface) {
+        return 0;
+      }
+
+      $rows = $model->getByPks($fkRow, $missingIds);
+
+      foreach ($missingKeys as $cacheKey => $idKey) {
+        self::store($cacheKey, $rows->get($idKey));
+      }
+
+      return $missingIds->count();
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Eager loads the foreign key held in $fkField for every row in the result
+   * set, avoiding a getByPk() per row when the set is iterated.
+   *
+   * @return int number of ids that needed resolving
+   */
+  public static function prefetchForResultSet(
+    PgResultSetInterface<PgRowInterface> $resultSet,
+    string $fkField,
+  ): int {
+
+    try {
+
+      $fk = null;
+      $fkIds = Vector {};
+
+      foreach ($resultSet->toArray() as $row) {
+
+        $field = $row->fields()->getTypedField($fkField);
+
+        if (!$field instanceof PgFk) {
+          throw new Exception(
+            'fkField='.$fkField.' is not a PgFk on row='.get_class($row),
+          );
+        }
+
+        list($isDefaultValue, $defaultErrors) = $field->isDefaultValue();
+
+        if ($isDefaultValue === true) {
+          continue;
+        }
+
+        $fk = $field;
+        $fkIds->add($field->get());
+
+      }
+
+      if ($fk === null) {
+        return 0;
+      }
+
+      return self::prefetch($fk->getFkModel(), $fk->getFkRow(), $fkIds);
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  public static function setMaxEntries(int $maxEntries): bool {
+
+    if ($maxEntries < 1) {
+      throw new Exception('maxEntries must be positive value='.$maxEntries);
+    }
+
+    self::$_maxEntries = $maxEntries;
+
+    self::evict();
+
+    return true;
+
+  }
+
+  public static function getMaxEntries(): int {
+    return self::$_maxEntries;
+  }
+
+  public static function count(): int {
+    return self::$_cache->count();
+  }
+
+  public static function clear(): bool {
+    self::$_cache->clear();
+    return true;
+  }
+
   public static function createCacheKey(
     classname<TModel> $fkModel,
     classname<TRow> $fkRow,
@@ -50,4 +194,27 @@ class FkCache<TModel as PgModelInterface, TRow as PgRowInterface> {
     return $fkModel.'|'.$fkRow.'|'.strval($fkId);
   }
 
+  private static function touch(string $cacheKey): ?PgRowInterface {
+    $row = self::$_cache->get($cacheKey);
+    self::$_cache->remove($cacheKey);
+    self::$_cache->set($cacheKey, $row);
+    return $row;
+  }
+
+  private static function store(string $cacheKey, ?PgRowInterface $row): void {
+    self::$_cache->remove($cacheKey);
+    self::$_cache->set($cacheKey, $row);
+    self::evict();
+  }
+
+  private static function evict(): void {
+    while (self::$_cache->count() > self::$_maxEntries) {
+      $oldestKey = self::$_cache->firstKey();
+      if ($oldestKey === null) {
+        return;
+      }
+      self::$_cache->remove($oldestKey);
+    }
+  }
+
 }
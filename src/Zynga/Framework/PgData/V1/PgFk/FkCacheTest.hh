@@ -0,0 +1,72 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\PgFk;
+
+use Zynga\Framework\Exception\V1\Exception;
+use Zynga\Framework\PgData\V1\PgFk\FkCache;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\BaseInventoryTest;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\InventoryModel;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\Inventory\ItemType;
+
+class FkCacheTest extends BaseInventoryTest {
+
+  public function setUp(): void {
+    parent::setUp();
+    FkCache::clear();
+    FkCache::setMaxEntries(FkCache::DEFAULT_MAX_ENTRIES);
+  }
+
+  public function testPrefetch(): void {
+
+    $ids = Vector {12387451, 12387452, 12387451};
+
+    $this->assertEquals(
+      2,
+      FkCache::prefetch(InventoryModel::class, ItemType::class, $ids),
+    );
+    $this->assertEquals(2, FkCache::count());
+
+    // Second pass should be entirely served from the process cache.
+    $this->assertEquals(
+      0,
+      FkCache::prefetch(InventoryModel::class, ItemType::class, $ids),
+    );
+
+    $row = FkCache::getFk(InventoryModel::class, ItemType::class, 12387451);
+
+    if ($row instanceof ItemType) {
+      $this->assertEquals('this-is-a-test-valueset-1', $row->name->get());
+    } else {
+      $this->fail('type returned should of been ItemType');
+    }
+
+  }
+
+  public function testPrefetch_Empty(): void {
+    $this->assertEquals(
+      0,
+      FkCache::prefetch(InventoryModel::class, ItemType::class, Vector {}),
+    );
+  }
+
+  public function testMaxEntries_Evicts(): void {
+
+    FkCache::setMaxEntries(1);
+
+    FkCache::prefetch(
+      InventoryModel::class,
+      ItemType::class,
+      Vector {12387451, 12387452},
+    );
+
+    $this->assertEquals(1, FkCache::count());
+    $this->assertEquals(1, FkCache::getMaxEntries());
+
+  }
+
+  public function testMaxEntries_Invalid(): void {
+    $this->expectException(Exception::class);
+    FkCache::setMaxEntries(0);
+  }
+
+}
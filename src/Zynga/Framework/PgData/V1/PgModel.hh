@@ -26,6 +26,7 @@ use Zynga\Framework\PgData\V1\Interfaces\PgWhereClauseInterface;
 use Zynga\Framework\PgData\V1\PgModel\Cache;
 use Zynga\Framework\PgData\V1\PgModel\Data;
 use Zynga\Framework\PgData\V1\PgModel\Db;
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRoutingStrategy;
 use Zynga\Framework\PgData\V1\PgModel\Reader;
 use Zynga\Framework\PgData\V1\PgModel\Stats;
 use Zynga\Framework\PgData\V1\PgModel\Writer;
@@ -165,6 +166,17 @@ abstract class PgModel implements PgModelInterface {
     }
   }
   
+  public function saveAll(
+    Traversable<PgRowInterface> $rows,
+    bool $shouldUnlock = true,
+  ): bool {
+    try {
+      return $this->writer()->saveAll($rows, $shouldUnlock);
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
   public function lockRowCache(PgRowInterface $row): bool {
     try {
       return $this->cache()->lockRowCache($row);
@@ -194,15 +206,29 @@ abstract class PgModel implements PgModelInterface {
     }
   }
 
+  public function getByPks<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    Vector<mixed> $ids,
+  ): Map<string, PgRowInterface> {
+
+    try {
+      return $this->reader()->getByPks($model, $ids);
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
   // As this can return a result set this doesn't let you lock all the tiems within
   // a result set as the number of edge cases introduced by that logic is not wanted.
+  // Passing $fields returns read-only rows that only carry those columns.
   public function get<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     ?PgWhereClauseInterface $where = null,
+    ?Vector<string> $fields = null,
   ): PgResultSetInterface<PgRowInterface> {
 
     try {
-      return $this->reader()->get($model, $where);
+      return $this->reader()->get($model, $where, $fields);
     } catch (Exception $e) {
       throw $e;
     }
@@ -215,4 +241,32 @@ abstract class PgModel implements PgModelInterface {
 
   abstract public function getWriteDatabaseName(): string;
 
+  // --
+  // Read replica routing, off by default. Return replica database names mapped
+  // to their routing weight to spread reads away from getReadDatabaseName().
+  // --
+  public function getReadReplicaDatabaseNames(): Map<string, int> {
+    return Map {};
+  }
+
+  public function getReadRoutingStrategy(): ReadRoutingStrategy {
+    return ReadRoutingStrategy::LEAST_OUTSTANDING;
+  }
+
+  // --
+  // Replication lag gating, off by default as the lag query is engine
+  // specific. Return a max lag and a query that selects the replica's lag in
+  // seconds as its only column to skip replicas that are too far behind, eg:
+  //   postgres: SELECT COALESCE(EXTRACT(EPOCH FROM
+  //               (now() - pg_last_xact_replay_timestamp())), 0)
+  //   mysql:    a heartbeat table, SHOW SLAVE STATUS is not a plain select.
+  // --
+  public function getMaxReplicationLagSeconds(): int {
+    return 0;
+  }
+
+  public function getReplicationLagSql(): string {
+    return '';
+  }
+
 }
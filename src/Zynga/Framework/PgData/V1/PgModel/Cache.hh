@@ -2,6 +2,7 @@
 
 namespace Zynga\Framework\PgData\V1\PgModel;
 
+use Zynga\Framework\Cache\V2\Interfaces\MemcacheDriverInterface;
 use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\Lockable\Cache\V1\Factory as LockableCacheFactory;
 use
@@ -72,15 +73,192 @@ class Cache implements CacheInterface {
 
   }
 
+  /**
+   * Drops the cached copy of a row without taking the lock. Used after a
+   * versioned update, the database is the only place the row can be trusted
+   * and the next read repopulates the cache from it. A compare then set
+   * against the payload would race with other writers, pecl memcache has no
+   * cas to close that gap.
+   */
+  public function invalidateRowCache(PgRowInterface $row): bool {
+
+    try {
+
+      $cache = $this->getDataCache()->getConfig()->getCache();
+
+      return $cache->delete($row);
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Fills a projected row (pk and projection already set) from its cached
+   * copy, false when there is none.
+   */
+  public function getProjectedRow(PgRowInterface $row): bool {
+
+    try {
+
+      $cache = $this->getProjectionCache();
+
+      if ($cache === null) {
+        return false;
+      }
+
+      $key = $this->createProjectionKey($cache, $row, false);
+
+      if ($key === '') {
+        return false;
+      }
+
+      $data = $cache->directGet($key);
+
+      if (!is_string($data) || $data === '') {
+        return false;
+      }
+
+      $row->import()->fromJSON($data);
+
+      return true;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  public function setProjectedRow(PgRowInterface $row): bool {
+
+    try {
+
+      $cache = $this->getProjectionCache();
+
+      if ($cache === null) {
+        return false;
+      }
+
+      $key = $this->createProjectionKey($cache, $row, true);
+
+      if ($key === '') {
+        return false;
+      }
+
+      return $cache->directSet(
+        $key,
+        $row->export()->asJSON(),
+        0,
+        $cache->getConfig()->getTTL(),
+      );
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Drops every cached projection of a row in one delete. Projection keys
+   * carry the row's current projection generation, removing the generation
+   * orphans all of them and the next projected read starts a new one.
+   */
+  public function invalidateProjectedRows(PgRowInterface $row): bool {
+
+    try {
+
+      $cache = $this->getProjectionCache();
+
+      if ($cache === null) {
+        return false;
+      }
+
+      return $cache->directDelete($this->createGenerationKey($cache, $row));
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  /**
+   * Projected rows share the data cache, under keys built here rather than
+   * by each cache config so full and projected rows can never collide.
+   */
+  private function getProjectionCache(): ?MemcacheDriverInterface {
+
+    $cache = $this->getDataCache()->getConfig()->getCache();
+
+    if ($cache instanceof MemcacheDriverInterface) {
+      return $cache;
+    }
+
+    return null;
+
+  }
+
+  private function createGenerationKey(
+    MemcacheDriverInterface $cache,
+    PgRowInterface $row,
+  ): string {
+    return $cache->getConfig()->createKeyFromStorableObject($row).':pgen';
+  }
+
+  /**
+   * '' when the row has no generation yet and $shouldCreate is false.
+   */
+  private function createProjectionKey(
+    MemcacheDriverInterface $cache,
+    PgRowInterface $row,
+    bool $shouldCreate,
+  ): string {
+
+    $generationKey = $this->createGenerationKey($cache, $row);
+
+    $generation = $cache->directGet($generationKey);
+
+    if (!is_string($generation) || $generation === '') {
+
+      if ($shouldCreate === false) {
+        return '';
+      }
+
+      // Whoever adds first wins, a concurrent reader picks theirs up.
+      $generation = uniqid('', true);
+
+      $added = $cache->directAdd(
+        $generationKey,
+        $generation,
+        0,
+        $cache->getConfig()->getTTL(),
+      );
+
+      if ($added !== true) {
+        $generation = $cache->directGet($generationKey);
+        if (!is_string($generation) || $generation === '') {
+          return '';
+        }
+      }
+
+    }
+
+    return
+      $generationKey.':'.$generation.$row->getProjectionChecksum();
+
+  }
+
   public function lockResultSetCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
+    ?Vector<string> $fields = null,
   ): bool {
     try {
       $pgModel = $this->pgModel();
 
       // Create a cachedRs out of the result set that was given.
-      $cachedRs = $pgModel->reader()->createCachedResultSet($model, $where);
+      $cachedRs =
+        $pgModel->reader()->createCachedResultSet($model, $where, $fields);
 
       $cache = $this->getResultSetCache();
 
@@ -94,12 +272,14 @@ class Cache implements CacheInterface {
   public function unlockResultSetCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
+    ?Vector<string> $fields = null,
   ): bool {
     try {
       $pgModel = $this->pgModel();
 
       // Create a cachedRs out of the result set that was given.
-      $cachedRs = $pgModel->reader()->createCachedResultSet($model, $where);
+      $cachedRs =
+        $pgModel->reader()->createCachedResultSet($model, $where, $fields);
 
       $cache = $this->getResultSetCache();
 
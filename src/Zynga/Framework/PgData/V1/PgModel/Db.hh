@@ -2,6 +2,7 @@
 
 namespace Zynga\Framework\PgData\V1\PgModel;
 
+use Zynga\Framework\Cache\V2\Interfaces\MemcacheDriverInterface;
 use Zynga\Framework\Database\V2\Factory as DatabaseFactory;
 use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
 use
@@ -11,32 +12,229 @@ use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\PgData\V1\Exceptions\UnsupportedValueTypeException;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\DbInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRouter;
 
 class Db implements DbInterface {
 
   private PgModelInterface $_pgModel;
+  private Map<string, string> $_routedHandles;
 
   public function __construct(PgModelInterface $pgModel) {
     $this->_pgModel = $pgModel;
+    $this->_routedHandles = Map {};
   }
 
   private function pgModel(): PgModelInterface {
     return $this->_pgModel;
   }
 
+  /**
+   * When the model has read replicas configured, reads are spread across the
+   * replicas that are within the lag threshold. Once this request has written
+   * through the model, reads stay on the primary so the writes are visible.
+   */
   public function getReadDatabase(): QueryableInterface {
     try {
 
       $pgModel = $this->pgModel();
-      return DatabaseFactory::factory(
-        DatabaseDriverInterface::class,
-        $pgModel->getReadDatabaseName(),
-      );
+
+      $replicas = $pgModel->getReadReplicaDatabaseNames();
+
+      if ($replicas->count() == 0) {
+        return DatabaseFactory::factory(
+          DatabaseDriverInterface::class,
+          $pgModel->getReadDatabaseName(),
+        );
+      }
+
+      $primaryName = $pgModel->getWriteDatabaseName();
+
+      $name = null;
+
+      if (ReadRouter::isPinnedToPrimary($primaryName) !== true) {
+        $name = ReadRouter::pick(
+          $this->getHealthyReplicas($replicas),
+          $pgModel->getReadRoutingStrategy(),
+        );
+      }
+
+      // Pinned, or every replica is lagging, the primary picks up the read.
+      if ($name === null) {
+        $name = $primaryName;
+      }
+
+      $dbh = DatabaseFactory::factory(DatabaseDriverInterface::class, $name);
+
+      ReadRouter::acquire($name);
+      $this->_routedHandles->set(spl_object_hash($dbh), $name);
+
+      return $dbh;
+
     } catch (Exception $e) {
       throw $e;
     }
   }
 
+  public function releaseReadDatabase(QueryableInterface $dbh): bool {
+
+    // The factory hands back one driver per name, so the handle always maps
+    // to the same database and the mapping can be kept around.
+    $name = $this->_routedHandles->get(spl_object_hash($dbh));
+
+    if ($name === null) {
+      return false;
+    }
+
+    return ReadRouter::release($name);
+
+  }
+
+  public function pinReadsToPrimary(): bool {
+
+    $pgModel = $this->pgModel();
+
+    if ($pgModel->getReadReplicaDatabaseNames()->count() == 0) {
+      return false;
+    }
+
+    return ReadRouter::pinToPrimary($pgModel->getWriteDatabaseName());
+
+  }
+
+  private function getHealthyReplicas(
+    Map<string, int> $replicas,
+  ): Map<string, int> {
+
+    $pgModel = $this->pgModel();
+
+    $maxLag = $pgModel->getMaxReplicationLagSeconds();
+
+    // Gating needs both a threshold and a way to measure, without either every
+    // replica is considered healthy.
+    if ($maxLag <= 0 || $pgModel->getReplicationLagSql() === '') {
+      return $replicas;
+    }
+
+    $healthy = Map {};
+
+    foreach ($replicas as $name => $weight) {
+      if ($this->getReplicationLag($name) <= $maxLag) {
+        $healthy->set($name, $weight);
+      }
+    }
+
+    return $healthy;
+
+  }
+
+  private function getReplicationLag(string $name): int {
+
+    $lag = ReadRouter::getCachedLag($name);
+
+    if ($lag !== null) {
+      return $lag;
+    }
+
+    // Statics end with the request, the sample other requests already took
+    // is kept in the model's data cache for LAG_CHECK_INTERVAL.
+    $lag = $this->getSharedLag($name);
+
+    if ($lag !== null) {
+      ReadRouter::setCachedLag($name, $lag);
+      return $lag;
+    }
+
+    // A replica we cannot measure is treated as too far behind to use.
+    $lag = PHP_INT_MAX;
+
+    try {
+
+      $dbh = DatabaseFactory::factory(DatabaseDriverInterface::class, $name);
+
+      $sth = $dbh->query($this->pgModel()->getReplicationLagSql());
+
+      if ($sth->hasMore() === true && $sth->next() === true) {
+        list($lagValue) = $sth->fetchVector();
+        $lag = intval($lagValue);
+      }
+
+    } catch (Exception $e) {
+      // fall through with the replica marked as lagging.
+    }
+
+    ReadRouter::setCachedLag($name, $lag);
+    $this->setSharedLag($name, $lag);
+
+    return $lag;
+
+  }
+
+  private function getLagCache(): ?MemcacheDriverInterface {
+
+    $cache =
+      $this->pgModel()->cache()->getDataCache()->getConfig()->getCache();
+
+    if ($cache instanceof MemcacheDriverInterface) {
+      return $cache;
+    }
+
+    return null;
+
+  }
+
+  private function getSharedLag(string $name): ?int {
+
+    try {
+
+      $cache = $this->getLagCache();
+
+      if ($cache === null) {
+        return null;
+      }
+
+      $lag = $cache->directGet(self::createLagKey($name));
+
+      if (is_int($lag)) {
+        return $lag;
+      }
+
+      if (is_string($lag) && is_numeric($lag)) {
+        return intval($lag);
+      }
+
+    } catch (Exception $e) {
+      // a cache we can not reach just means measuring again.
+    }
+
+    return null;
+
+  }
+
+  private function setSharedLag(string $name, int $lag): void {
+
+    try {
+
+      $cache = $this->getLagCache();
+
+      if ($cache !== null) {
+        $cache->directSet(
+          self::createLagKey($name),
+          $lag,
+          0,
+          ReadRouter::LAG_CHECK_INTERVAL,
+        );
+      }
+
+    } catch (Exception $e) {
+      // the sample still serves the rest of this request.
+    }
+
+  }
+
+  private static function createLagKey(string $name): string {
+    return 'pg:replicationLag:'.$name;
+  }
+
   public function getWriteDatabase(): QueryableInterface {
     try {
       $pgModel = $this->pgModel();
@@ -57,6 +255,13 @@ class Db implements DbInterface {
       return $dbh->quote()->floatValue($value);
     } else if (is_int($value)) {
       return $dbh->quote()->intValue($value);
+    } else if ($value instanceof Traversable) {
+      // Lists are rendered as a parenthesized set for IN / NOT IN clauses.
+      $quotedValues = Vector {};
+      foreach ($value as $item) {
+        $quotedValues->add($this->quoteValue($dbh, $item));
+      }
+      return '('.implode(',', $quotedValues).')';
     }
 
     throw new UnsupportedValueTypeException('value='.gettype($value));
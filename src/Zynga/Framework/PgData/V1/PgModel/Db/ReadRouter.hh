@@ -0,0 +1,171 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\PgModel\Db;
+
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRoutingStrategy;
+
+/**
+ * Request level bookkeeping for spreading reads across replicas.
+ *
+ * State is static so every model pointed at the same databases shares it. HHVM
+ * resets statics at the end of every request, which is what expires the
+ * primary pin, but it also means:
+ *
+ *  - Outstanding counts only see this request's own reads. Handles are
+ *    released before the next pick, so LEAST_OUTSTANDING amounts to round
+ *    robin within the request, it knows nothing of the load other requests
+ *    put on a replica. Where a request starts in the rotation is random so
+ *    short requests do not all pile onto the first replica.
+ *  - The lag samples here are a per request copy. Db keeps the shared sample
+ *    in the model's data cache for LAG_CHECK_INTERVAL, so lag gating costs one
+ *    lag query per replica per interval rather than per request.
+ */
+class ReadRouter {
+  const int LAG_CHECK_INTERVAL = 5;
+
+  private static Map<string, int> $_outstanding = Map {};
+  private static Map<string, int> $_routed = Map {};
+  private static Map<string, int> $_lagSeconds = Map {};
+  private static Map<string, int> $_lagCheckedAt = Map {};
+  private static Set<string> $_pinned = Set {};
+
+  /**
+   * Picks a replica from the candidates (name => weight), null if there are
+   * no candidates to choose from.
+   */
+  public static function pick(
+    Map<string, int> $candidates,
+    ReadRoutingStrategy $strategy,
+  ): ?string {
+
+    if ($candidates->count() == 0) {
+      return null;
+    }
+
+    if ($strategy == ReadRoutingStrategy::WEIGHTED) {
+      return self::pickWeighted($candidates);
+    }
+
+    return self::pickLeastOutstanding($candidates);
+
+  }
+
+  private static function pickWeighted(Map<string, int> $candidates): ?string {
+
+    $totalWeight = 0;
+
+    foreach ($candidates as $name => $weight) {
+      $totalWeight += max(0, $weight);
+    }
+
+    if ($totalWeight == 0) {
+      return self::pickLeastOutstanding($candidates);
+    }
+
+    $target = mt_rand(1, $totalWeight);
+
+    foreach ($candidates as $name => $weight) {
+      $target -= max(0, $weight);
+      if ($target <= 0) {
+        return $name;
+      }
+    }
+
+    return null;
+
+  }
+
+  // Ties on in flight queries fall back to the replica that has been handed
+  // out the least, which keeps sequential reads spread around.
+  private static function pickLeastOutstanding(
+    Map<string, int> $candidates,
+  ): ?string {
+
+    $picked = null;
+    $pickedOutstanding = PHP_INT_MAX;
+    $pickedRouted = PHP_INT_MAX;
+
+    // Start the scan at a random candidate, a fresh request has every count
+    // at zero and would otherwise always open on the first replica.
+    $names = $candidates->keys();
+    $start = mt_rand(0, $names->count() - 1);
+
+    for ($i = 0; $i < $names->count(); $i++) {
+      $name = $names[($start + $i) % $names->count()];
+
+      $outstanding = self::getOutstanding($name);
+      $routed = self::getRouted($name);
+
+      if ($outstanding < $pickedOutstanding ||
+          ($outstanding == $pickedOutstanding && $routed < $pickedRouted)) {
+        $picked = $name;
+        $pickedOutstanding = $outstanding;
+        $pickedRouted = $routed;
+      }
+
+    }
+
+    return $picked;
+
+  }
+
+  public static function acquire(string $name): bool {
+    self::$_outstanding->set($name, self::getOutstanding($name) + 1);
+    self::$_routed->set($name, self::getRouted($name) + 1);
+    return true;
+  }
+
+  public static function release(string $name): bool {
+    self::$_outstanding->set($name, max(0, self::getOutstanding($name) - 1));
+    return true;
+  }
+
+  public static function getOutstanding(string $name): int {
+    return intval(self::$_outstanding->get($name));
+  }
+
+  public static function getRouted(string $name): int {
+    return intval(self::$_routed->get($name));
+  }
+
+  /**
+   * Cached lag for a replica, null when it has never been checked or the last
+   * check is older than LAG_CHECK_INTERVAL.
+   */
+  public static function getCachedLag(string $name): ?int {
+
+    $checkedAt = self::$_lagCheckedAt->get($name);
+
+    if ($checkedAt === null || time() - $checkedAt > self::LAG_CHECK_INTERVAL) {
+      return null;
+    }
+
+    return self::$_lagSeconds->get($name);
+
+  }
+
+  public static function setCachedLag(string $name, int $lagSeconds): bool {
+    self::$_lagSeconds->set($name, $lagSeconds);
+    self::$_lagCheckedAt->set($name, time());
+    return true;
+  }
+
+  public static function pinToPrimary(string $primaryName): bool {
+    self::$_pinned->add($primaryName);
+    return true;
+  }
+
+  public static function isPinnedToPrimary(string $primaryName): bool {
+    return self::$_pinned->contains($primaryName);
+  }
+
+  public static function clear(): bool {
+    self::$_outstanding->clear();
+    self::$_routed->clear();
+    self::$_lagSeconds->clear();
+    self::$_lagCheckedAt->clear();
+    self::$_pinned->clear();
+    return true;
+  }
+
+}
@@ -0,0 +1,83 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\PgModel\Db;
+
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRouter;
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRoutingStrategy;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class ReadRouterTest extends TestCase {
+
+  public function setUp(): void {
+    parent::setUp();
+    ReadRouter::clear();
+  }
+
+  public function tearDown(): void {
+    ReadRouter::clear();
+    parent::tearDown();
+  }
+
+  public function testPick_NoCandidates(): void {
+    $this->assertEquals(
+      null,
+      ReadRouter::pick(Map {}, ReadRoutingStrategy::LEAST_OUTSTANDING),
+    );
+  }
+
+  public function testPick_LeastOutstanding(): void {
+
+    $replicas = Map {'replica-a' => 1, 'replica-b' => 1};
+
+    ReadRouter::acquire('replica-a');
+
+    $this->assertEquals(
+      'replica-b',
+      ReadRouter::pick($replicas, ReadRoutingStrategy::LEAST_OUTSTANDING),
+    );
+
+    ReadRouter::release('replica-a');
+    ReadRouter::acquire('replica-b');
+    ReadRouter::release('replica-b');
+    ReadRouter::acquire('replica-b');
+    ReadRouter::release('replica-b');
+
+    // Nothing in flight, a has been handed out less often.
+    $this->assertEquals(
+      'replica-a',
+      ReadRouter::pick($replicas, ReadRoutingStrategy::LEAST_OUTSTANDING),
+    );
+
+  }
+
+  public function testPick_WeightedSkipsZeroWeight(): void {
+
+    $replicas = Map {'replica-a' => 0, 'replica-b' => 10};
+
+    for ($i = 0; $i < 20; $i++) {
+      $this->assertEquals(
+        'replica-b',
+        ReadRouter::pick($replicas, ReadRoutingStrategy::WEIGHTED),
+      );
+    }
+
+  }
+
+  public function testRelease_NeverNegative(): void {
+    ReadRouter::release('replica-a');
+    $this->assertEquals(0, ReadRouter::getOutstanding('replica-a'));
+  }
+
+  public function testCachedLag(): void {
+    $this->assertEquals(null, ReadRouter::getCachedLag('replica-a'));
+    ReadRouter::setCachedLag('replica-a', 12);
+    $this->assertEquals(12, ReadRouter::getCachedLag('replica-a'));
+  }
+
+  public function testPinToPrimary(): void {
+    $this->assertFalse(ReadRouter::isPinnedToPrimary('primary'));
+    ReadRouter::pinToPrimary('primary');
+    $this->assertTrue(ReadRouter::isPinnedToPrimary('primary'));
+  }
+
+}
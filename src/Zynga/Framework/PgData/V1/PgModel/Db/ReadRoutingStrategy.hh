@@ -0,0 +1,8 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\PgModel\Db;
+
+enum ReadRoutingStrategy : int {
+  LEAST_OUTSTANDING = 2;
+  WEIGHTED = 4;
+}
@@ -0,0 +1,184 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\PgModel;
+
+use Zynga\Framework\Cache\V2\Driver\InMemory as InMemoryCache;
+use Zynga\Framework\Database\V2\Driver\Mock as MockDriver;
+use Zynga\Framework\Database\V2\Factory as DatabaseFactory;
+use
+  Zynga\Framework\Database\V2\Interfaces\DriverInterface as DatabaseDriverInterface
+;
+use Zynga\Framework\PgData\V1\PgModel\Db\ReadRouter;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\InventoryModel;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class ReplicatedInventoryModel extends InventoryModel {
+  public int $maxLag = 0;
+  public string $lagSql = '';
+
+  public function getReadDatabaseName(): string {
+    return 'Mock';
+  }
+
+  public function getWriteDatabaseName(): string {
+    return 'Mock';
+  }
+
+  public function getReadReplicaDatabaseNames(): Map<string, int> {
+    return Map {'Mock_ReadOnly' => 1};
+  }
+
+  public function getMaxReplicationLagSeconds(): int {
+    return $this->maxLag;
+  }
+
+  public function getReplicationLagSql(): string {
+    return $this->lagSql;
+  }
+
+}
+
+class DbTest extends TestCase {
+
+  public function setUp(): void {
+    parent::setUp();
+    ReadRouter::clear();
+
+    // Lag samples are shared through the data cache, start each test clean.
+    $cache = (new InventoryModel())
+      ->cache()
+      ->getDataCache()
+      ->getConfig()
+      ->getCache();
+
+    if ($cache instanceof InMemoryCache) {
+      $cache->clearInMemoryCache();
+    }
+  }
+
+  public function tearDown(): void {
+    ReadRouter::clear();
+    parent::tearDown();
+  }
+
+  private function getDriver(string $name): DatabaseDriverInterface {
+    return DatabaseFactory::factory(DatabaseDriverInterface::class, $name);
+  }
+
+  public function testGetReadDatabase_NoReplicas(): void {
+
+    $db = new Db(new InventoryModel());
+
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Test_Mysql'), $dbh);
+    // Nothing was routed so there is nothing to release.
+    $this->assertFalse($db->releaseReadDatabase($dbh));
+    $this->assertFalse($db->pinReadsToPrimary());
+
+  }
+
+  public function testGetReadDatabase_RoutesToReplica(): void {
+
+    $db = new Db(new ReplicatedInventoryModel());
+
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Mock_ReadOnly'), $dbh);
+    $this->assertEquals(1, ReadRouter::getOutstanding('Mock_ReadOnly'));
+
+    $this->assertTrue($db->releaseReadDatabase($dbh));
+    $this->assertEquals(0, ReadRouter::getOutstanding('Mock_ReadOnly'));
+
+  }
+
+  public function testGetReadDatabase_PinnedAfterWrite(): void {
+
+    $db = new Db(new ReplicatedInventoryModel());
+
+    $this->assertTrue($db->pinReadsToPrimary());
+
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Mock'), $dbh);
+    $this->assertEquals(0, ReadRouter::getRouted('Mock_ReadOnly'));
+    $this->assertTrue($db->releaseReadDatabase($dbh));
+
+  }
+
+  public function testGetReadDatabase_LaggingReplicaSkipped(): void {
+
+    $replica = $this->getDriver('Mock_ReadOnly');
+
+    if (!$replica instanceof MockDriver) {
+      $this->fail('Mock_ReadOnly should hand back the mock driver');
+      return;
+    }
+
+    $replica->resetResultSets();
+    $replica->addResultSet(Vector {Vector {120}});
+
+    $model = new ReplicatedInventoryModel();
+    $model->maxLag = 30;
+    $model->lagSql = 'SELECT lag_seconds FROM replication_heartbeat';
+
+    $db = new Db($model);
+
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Mock'), $dbh);
+    $this->assertEquals(120, ReadRouter::getCachedLag('Mock_ReadOnly'));
+    $this->assertTrue($db->releaseReadDatabase($dbh));
+
+  }
+
+  public function testGetReadDatabase_LagSampleOutlivesRequest(): void {
+
+    $replica = $this->getDriver('Mock_ReadOnly');
+
+    if (!$replica instanceof MockDriver) {
+      $this->fail('Mock_ReadOnly should hand back the mock driver');
+      return;
+    }
+
+    $replica->resetResultSets();
+    $replica->addResultSet(Vector {Vector {90}});
+
+    $model = new ReplicatedInventoryModel();
+    $model->maxLag = 30;
+    $model->lagSql = 'SELECT lag_seconds FROM replication_heartbeat';
+
+    $db = new Db($model);
+    $db->releaseReadDatabase($db->getReadDatabase());
+
+    // A new request starts with empty statics, the sample comes from the
+    // cache instead of another lag query.
+    ReadRouter::clear();
+    $replica->resetResultSets();
+
+    $db = new Db($model);
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Mock'), $dbh);
+    $this->assertEquals(90, ReadRouter::getCachedLag('Mock_ReadOnly'));
+    $this->assertTrue($db->releaseReadDatabase($dbh));
+
+  }
+
+  public function testGetReadDatabase_LagGatingNeedsSql(): void {
+
+    // A threshold without a lag query leaves the replicas in rotation.
+    $model = new ReplicatedInventoryModel();
+    $model->maxLag = 30;
+
+    $db = new Db($model);
+
+    $dbh = $db->getReadDatabase();
+
+    $this->assertSame($this->getDriver('Mock_ReadOnly'), $dbh);
+    $this->assertEquals(null, ReadRouter::getCachedLag('Mock_ReadOnly'));
+    $this->assertTrue($db->releaseReadDatabase($dbh));
+
+  }
+
+}
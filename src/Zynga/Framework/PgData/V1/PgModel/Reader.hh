@@ -2,6 +2,7 @@
 
 namespace Zynga\Framework\PgData\V1\PgModel;
 
+use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
 use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\ReaderInterface;
@@ -114,11 +115,84 @@ class Reader implements ReaderInterface {
     }
   }
 
+  /**
+   * Resolves a batch of primary keys in one trip to the database. Rows that
+   * are already within the data cache are served from there, the remainder are
+   * fetched with a single pk IN (...) select. Rows are returned unlocked and
+   * keyed by strval(pk), ids that do not exist are absent from the map.
+   */
+  public function getByPks<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    Vector<mixed> $ids,
+  ): Map<string, PgRowInterface> {
+
+    try {
+
+      $pgModel = $this->pgModel();
+
+      $rows = Map {};
+
+      // 0) Collapse duplicates and serve what we can from the data cache.
+      $seenIds = Set {};
+      $missingIds = Vector {};
+
+      foreach ($ids as $id) {
+
+        $idKey = strval($id);
+
+        if ($seenIds->contains($idKey)) {
+          continue;
+        }
+
+        $seenIds->add($idKey);
+
+        $cached = $this->fetchSingleRowFromDataCache($model, $id, false);
+
+        if ($cached instanceof PgRowInterface) {
+          $pgModel->stats()->incrementCacheHits();
+          $rows->set($idKey, $cached);
+          continue;
+        }
+
+        $pgModel->stats()->incrementCacheMisses();
+        $missingIds->add($id);
+
+      }
+
+      if ($missingIds->count() == 0) {
+        return $rows;
+      }
+
+      // 1) One select for every id that missed cache.
+      $pkName = $pgModel->data()->getPkFromClassName($model);
+
+      $where = new PgWhereClause($pgModel);
+      $where->and($pkName, PgWhereOperand::IN, $missingIds);
+
+      // 2) fetchResultSetFromDatabase writes each row back to the data cache.
+      $resultSet = $this->fetchResultSetFromDatabase($model, $where, true);
+
+      foreach ($resultSet->toArray() as $row) {
+        $rows->set(strval($row->getPrimaryKeyTyped()->get()), $row);
+      }
+
+      return $rows;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
   // As this can return a result set this doesn't let you lock all the items within
   // a result set as the number of edge cases introduced by that logic is not wanted.
+  //
+  // Providing $fields projects the select down to those columns (plus the pk),
+  // the rows returned are read-only and cached apart from the full rows.
   public function get<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     ?PgWhereClauseInterface $where = null,
+    ?Vector<string> $fields = null,
   ): PgResultSetInterface<PgRowInterface> {
 
     try {
@@ -133,7 +207,7 @@ class Reader implements ReaderInterface {
 
       // 2) Attempt to pull a cached result set in from the wild.
       $cachedResults =
-        $this->fetchResultSetFromResultSetCache($model, $where);
+        $this->fetchResultSetFromResultSetCache($model, $where, $fields);
 
       if ($cachedResults instanceof PgResultSetInterface) {
         $pgModel->stats()->incrementCacheHits();
@@ -143,16 +217,21 @@ class Reader implements ReaderInterface {
       }
 
       // 3) Lock the dataset in question for updating.
-      $pgModel->cache()->lockResultSetCache($model, $where);
+      $pgModel->cache()->lockResultSetCache($model, $where, $fields);
 
       // 4) Fetch the result set from the database + mc (if needed)
-      $resultSet = $this->fetchResultSetFromDatabase($model, $where, true);
+      if ($fields === null) {
+        $resultSet = $this->fetchResultSetFromDatabase($model, $where, true);
+      } else {
+        $resultSet =
+          $this->fetchProjectedResultSetFromDatabase($model, $where, $fields);
+      }
 
       // 5) Save the result set back to cache
-      $this->setResultSetToResultSetCache($model, $where, $resultSet);
+      $this->setResultSetToResultSetCache($model, $where, $resultSet, $fields);
 
       // 6) Unlock the dataset
-      $pgModel->cache()->unlockResultSetCache($model, $where);
+      $pgModel->cache()->unlockResultSetCache($model, $where, $fields);
 
       return $resultSet;
 
@@ -165,16 +244,19 @@ class Reader implements ReaderInterface {
   public function createCachedResultSet<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $pgWhere,
+    ?Vector<string> $fields = null,
   ): PgCachedResultSet<TypeInterface> {
     try {
 
-      $pgModel = $this->pgModel();
-
-      $tobj = $pgModel->data()->createRowObjectFromClassName($model);
+      $tobj = $this->createProjectedRowObject($model, $fields);
       $pkTyped = $tobj->getPrimaryKeyTyped();
       $pkType = get_class($pkTyped);
 
-      $cache = new PgCachedResultSet(UInt64Box::class, $pgWhere);
+      $cache = new PgCachedResultSet(
+        UInt64Box::class,
+        $pgWhere,
+        $tobj->getProjectionChecksum(),
+      );
 
       return $cache;
 
@@ -183,18 +265,27 @@ class Reader implements ReaderInterface {
     }
   }
 
+  private function createProjectedRowObject<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    ?Vector<string> $fields,
+  ): PgRowInterface {
+    try {
+      $obj = $this->pgModel()->data()->createRowObjectFromClassName($model);
+      $obj->setProjection($fields);
+      return $obj;
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
   private function createSql(
+    QueryableInterface $dbh,
     PgRowInterface $row,
     PgWhereClauseInterface $where,
   ): string {
     try {
       $pgModel = $this->pgModel();
-      return SqlGenerator::getSelectSql(
-        $pgModel->db()->getReadDatabase(),
-        $pgModel,
-        $row,
-        $where,
-      );
+      return SqlGenerator::getSelectSql($dbh, $pgModel, $row, $where);
     } catch (Exception $e) {
       throw $e;
     }
@@ -203,7 +294,7 @@ class Reader implements ReaderInterface {
   private function fetchResultSetFromDatabase<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
-    bool $releaseLockOnSet
+    bool $releaseLockOnSet,
   ): PgResultSetInterface<PgRowInterface> {
 
     try {
@@ -217,14 +308,18 @@ class Reader implements ReaderInterface {
       // Snag the pk off the class name.
       $pkKey = $pgModel->data()->getPkFromClassName($model);
 
-      $tobj = $pgModel->data()->createRowObjectFromClassName($model);
-      $sql = $this->createSql($tobj, $where);
-
       // X) Get a database handle.
       $dbh = $pgModel->db()->getReadDatabase();
 
-      // X) Run the query against the database.
-      $sth = $dbh->query($sql);
+      // X) Run the query against the database, handing the handle back to the
+      //    read routing once it is done.
+      try {
+        $tobj = $pgModel->data()->createRowObjectFromClassName($model);
+        $sql = $this->createSql($dbh, $tobj, $where);
+        $sth = $dbh->query($sql);
+      } finally {
+        $pgModel->db()->releaseReadDatabase($dbh);
+      }
 
       // X) Increment stats.
       $pgModel->stats()->incrementSqlSelects();
@@ -276,22 +371,77 @@ class Reader implements ReaderInterface {
 
   }
 
+  /**
+   * Projected rows are partial copies, they are cached under their own keys
+   * (see Cache::setProjectedRow) and never replace the full row. The row lock
+   * is held while caching so a concurrent save cannot be overwritten by the
+   * copy read before it, a row some writer has locked is just not cached.
+   */
+  private function fetchProjectedResultSetFromDatabase<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    PgWhereClauseInterface $where,
+    Vector<string> $fields,
+  ): PgResultSetInterface<PgRowInterface> {
+
+    try {
+
+      $pgModel = $this->pgModel();
+
+      $resultSet = new PgResultSet($model);
+
+      $dbh = $pgModel->db()->getReadDatabase();
+
+      try {
+        $tobj = $this->createProjectedRowObject($model, $fields);
+        $sql = $this->createSql($dbh, $tobj, $where);
+        $sth = $dbh->query($sql);
+      } finally {
+        $pgModel->db()->releaseReadDatabase($dbh);
+      }
+
+      $pgModel->stats()->incrementSqlSelects();
+
+      if ($sth->wasSuccessful() != true || $sth->getNumRows() == 0) {
+        return $resultSet;
+      }
+
+      while ($sth->hasMore() === true && $sth->next() === true) {
+        $obj = $this->createProjectedRowObject($model, $fields);
+        $pgModel->data()->hydrateDataToRowObject($obj, $sth->fetchMap());
+
+        if ($pgModel->cache()->lockRowCache($obj) === true) {
+          $pgModel->cache()->setProjectedRow($obj);
+          $pgModel->cache()->unlockRowCache($obj);
+        }
+
+        $resultSet->add($obj);
+      }
+
+      return $resultSet;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
   private function fetchResultSetFromResultSetCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
+    ?Vector<string> $fields,
   ): ?PgResultSetInterface<PgRowInterface> {
 
     try {
 
       $pgModel = $this->pgModel();
 
-      $rsData = $this->createCachedResultSet($model, $where);
+      $rsData = $this->createCachedResultSet($model, $where, $fields);
 
       $cache = $pgModel->cache()->getResultSetCache();
       $rsData = $cache->get($rsData);
 
       if ($rsData instanceof PgCachedResultSet) {
-        return $this->thawCachedResultSet($model, $rsData);
+        return $this->thawCachedResultSet($model, $rsData, $fields);
       }
 
       return null;
@@ -304,7 +454,7 @@ class Reader implements ReaderInterface {
   private function fetchSingleRowFromDataCache<TModelClass as PgRowInterface>(
     classname<TModelClass> $model,
     mixed $id,
-    bool $shouldLock
+    bool $shouldLock,
   ): ?PgRowInterface {
     try {
 
@@ -352,13 +502,14 @@ class Reader implements ReaderInterface {
     classname<TModelClass> $model,
     PgWhereClauseInterface $where,
     PgResultSetInterface<PgRowInterface> $resultSet,
+    ?Vector<string> $fields,
   ): bool {
     try {
 
       $pgModel = $this->pgModel();
 
       // Create a cachedRs out of the result set that was given.
-      $cachedRs = $this->createCachedResultSet($model, $where);
+      $cachedRs = $this->createCachedResultSet($model, $where, $fields);
 
       foreach ($resultSet->toArray() as $row) {
         $pk = $row->getPrimaryKeyTyped();
@@ -380,7 +531,8 @@ class Reader implements ReaderInterface {
   Tv as TypeInterface>(
     classname<TModelClass> $model,
     PgCachedResultSet<Tv> $rsData,
-  ): PgResultSetInterface<PgRowInterface> {
+    ?Vector<string> $fields,
+  ): ?PgResultSetInterface<PgRowInterface> {
 
     // Create a result set to return.
     $rs = new PgResultSet($model);
@@ -390,7 +542,17 @@ class Reader implements ReaderInterface {
 
       $pk = $pkId->get();
 
-      $obj = $this->getByPk($model, $pk, false);
+      if ($fields === null) {
+        $obj = $this->getByPk($model, $pk, false);
+      } else {
+        // A projection dropped by a write (or expired) makes the whole set a
+        // miss, it is re-read from the database.
+        $obj = $this->createProjectedRowObject($model, $fields);
+        $obj->getPrimaryKeyTyped()->set($pk);
+        if ($this->pgModel()->cache()->getProjectedRow($obj) !== true) {
+          return null;
+        }
+      }
 
       if ($obj instanceof PgRowInterface) {
         $rs->add($obj);
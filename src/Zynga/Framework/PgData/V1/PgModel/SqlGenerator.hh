@@ -3,6 +3,7 @@
 namespace Zynga\Framework\PgData\V1\PgModel;
 
 use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
+use Zynga\Framework\PgData\V1\Exceptions\FailedToFindFieldOnObjectException;
 use Zynga\Framework\PgData\V1\Exceptions\NoFieldsOnObjectException;
 use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
@@ -32,10 +33,24 @@ class SqlGenerator {
         throw new NoFieldsOnObjectException('obj='.get_class($obj));
       }
 
-      // 2) Build a list of fields to include on the select
+      // 2) Build a list of fields to include on the select, projected rows
+      //    only select the fields they carry.
       $selectFields = Vector {};
-      foreach ($fieldMap as $fieldName => $fieldType) {
-        $selectFields->add($fieldName);
+      $projection = $obj->getProjection();
+
+      if ($projection !== null) {
+        foreach ($projection as $fieldName) {
+          if (!$fieldMap->containsKey($fieldName)) {
+            throw new FailedToFindFieldOnObjectException(
+              'Failed to find field='.$fieldName.' on '.get_class($obj),
+            );
+          }
+          $selectFields->add($fieldName);
+        }
+      } else {
+        foreach ($fieldMap as $fieldName => $fieldType) {
+          $selectFields->add($fieldName);
+        }
       }
 
       // 3) snag the table name off the obj
@@ -126,6 +141,8 @@ class SqlGenerator {
         throw new NoFieldsOnObjectException('obj='.get_class($obj));
       }
 
+      $versionField = $obj->getVersionField();
+
       foreach ($fieldMap as $fieldName => $fieldType) {
 
         // skip the pk.
@@ -133,6 +150,12 @@ class SqlGenerator {
           continue;
         }
 
+        // the version is bumped by the database, not taken from the row.
+        if ($fieldName == $versionField) {
+          $quotedValues->add($fieldName.' = '.$fieldName.' + 1');
+          continue;
+        }
+
         $fieldObj = $obj->fields()->getTypedField($fieldName);
         $fieldValue = $fieldObj->get();
 
@@ -146,6 +169,17 @@ class SqlGenerator {
       $id = $pk->get();
       $where = new PgWhereClause($model);
       $where->and($obj->getPrimaryKey(), PgWhereOperand::EQUALS, $id);
+
+      // optimistic rows only update if nobody has saved since we read it.
+      if ($versionField !== '') {
+        if (!$fieldMap->containsKey($versionField)) {
+          throw new FailedToFindFieldOnObjectException(
+            'Failed to find field='.$versionField.' on '.get_class($obj),
+          );
+        }
+        $where->and($versionField, PgWhereOperand::EQUALS, $obj->getVersion());
+      }
+
       $whereClause = $where->buildSql($dbh, $obj);
 
       $tableName = $obj->getTableName();
@@ -2,7 +2,10 @@
 
 namespace Zynga\Framework\PgData\V1\PgModel;
 
+use Zynga\Framework\Database\V2\Interfaces\QueryableInterface;
 use Zynga\Framework\Exception\V1\Exception;
+use Zynga\Framework\PgData\V1\Exceptions\ReadOnlyRowException;
+use Zynga\Framework\PgData\V1\Exceptions\VersionConflictException;
 use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\WriterInterface;
 use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
@@ -28,6 +31,8 @@ class Writer implements WriterInterface {
 
     try {
 
+      $this->assertIsWritable($row);
+
       $pk = $row->getPrimaryKeyTyped();
 
       list($isDefaultValue, $isDefaultError) = $pk->isDefaultValue();
@@ -57,6 +62,7 @@ class Writer implements WriterInterface {
         $result = $dbh->query($insertSql);
 
         if ($result->wasSuccessful() === true) {
+          $pgModel->db()->pinReadsToPrimary();
           $dataCache->set($row);
           if($shouldUnlock === true) {
             $pgCache->unlockRowCache($row);
@@ -87,6 +93,8 @@ class Writer implements WriterInterface {
   public function save(PgRowInterface $obj, bool $shouldUnlock): bool {
     try {
 
+      $this->assertIsWritable($obj);
+
       $pk = $obj->getPrimaryKeyTyped();
 
       if ($pk->isDefaultValue() === true) {
@@ -95,6 +103,10 @@ class Writer implements WriterInterface {
         );
       }
 
+      if ($obj->getVersionField() !== '') {
+        return $this->saveOptimistic($obj, $shouldUnlock);
+      }
+
       $pgModel = $this->pgModel();
       
       $pgCache = $pgModel->cache();
@@ -112,7 +124,9 @@ class Writer implements WriterInterface {
 
       if ($result->wasSuccessful() === true) {
 
+        $pgModel->db()->pinReadsToPrimary();
         $dataCache->set($obj);
+        $pgCache->invalidateProjectedRows($obj);
         if($shouldUnlock === true) {
           $pgCache->unlockRowCache($obj);
         }
@@ -132,6 +146,154 @@ class Writer implements WriterInterface {
 
   }
   
+  /**
+   * Saves a set of rows as a single atomic statement batch, one round trip
+   * instead of one per row plus the transaction around them.
+   * Versioned rows go in the same batch, the whole batch runs inside an
+   * explicit transaction so each versioned UPDATE can have its row count
+   * checked, any conflict rolls every row back and raises
+   * VersionConflictException.
+   * Expects the api dev to already hold a lock on every unversioned row.
+   * Will only unlock if the api dev asks it
+   */
+  public function saveAll(
+    Traversable<PgRowInterface> $rows,
+    bool $shouldUnlock,
+  ): bool {
+    try {
+
+      $pgModel = $this->pgModel();
+      $pgCache = $pgModel->cache();
+      $dataCache = $pgCache->getDataCache();
+
+      $dbh = $pgModel->db()->getWriteDatabase();
+
+      $batchRows = Vector {};
+      $statements = Vector {};
+      $hasVersionedRows = false;
+
+      foreach ($rows as $obj) {
+
+        $this->assertIsWritable($obj);
+
+        $pk = $obj->getPrimaryKeyTyped();
+
+        if ($pk->isDefaultValue() === true) {
+          throw new Exception(
+            'Primary key is default value still. value='.strval($pk->get()),
+          );
+        }
+
+        if ($obj->getVersionField() !== '') {
+          $hasVersionedRows = true;
+        } else if ($dataCache->isLocked($obj) === false) {
+          throw new Exception(
+            'No lock acquired before calling saveAll on obj='.
+            $obj->export()->asJSON(),
+          );
+        }
+
+        $batchRows->add($obj);
+        $statements->add(SqlGenerator::getUpdateSql($dbh, $pgModel, $obj));
+
+      }
+
+      if ($statements->count() == 0) {
+        return true;
+      }
+
+      if ($hasVersionedRows === true) {
+        $success = $this->saveAllVersioned($dbh, $batchRows, $statements);
+      } else {
+        $success = true;
+        foreach ($dbh->queryBatch($statements, true) as $result) {
+          if ($result->wasSuccessful() !== true) {
+            $success = false;
+          }
+        }
+      }
+
+      if ($success === true) {
+        $pgModel->db()->pinReadsToPrimary();
+        foreach ($batchRows as $obj) {
+          if ($obj->getVersionField() !== '') {
+            $obj->fields()->getTypedField($obj->getVersionField())
+              ->set($obj->getVersion() + 1);
+            $pgCache->invalidateRowCache($obj);
+          } else {
+            $dataCache->set($obj);
+          }
+          $pgCache->invalidateProjectedRows($obj);
+        }
+      }
+
+      if ($shouldUnlock === true) {
+        foreach ($batchRows as $obj) {
+          $pgCache->unlockRowCache($obj);
+        }
+      }
+
+      return $success;
+
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
+  /**
+   * Runs the batch inside an explicit transaction so the versioned row
+   * counts can be checked before anything is committed.
+   */
+  private function saveAllVersioned(
+    QueryableInterface $dbh,
+    Vector<PgRowInterface> $batchRows,
+    Vector<string> $statements,
+  ): bool {
+
+    $transaction = $dbh->getTransaction();
+
+    $transaction->begin();
+
+    try {
+
+      // Already inside our transaction, the batch must not bracket itself.
+      $results = $dbh->queryBatch($statements, false);
+
+      foreach ($results as $offset => $result) {
+
+        if ($result->wasSuccessful() !== true) {
+          $transaction->rollback();
+          return false;
+        }
+
+        $obj = $batchRows[$offset];
+
+        if ($obj->getVersionField() !== '' && $result->getNumRows() != 1) {
+          $transaction->rollback();
+          $this->pgModel()->cache()->invalidateRowCache($obj);
+          throw new VersionConflictException(
+            'Row was modified by another writer version='.
+            $obj->getVersion().
+            ' obj='.
+            $obj->export()->asJSON(),
+          );
+        }
+
+      }
+
+      $transaction->commit();
+
+      return true;
+
+    } catch (VersionConflictException $e) {
+      throw $e;
+    } catch (Exception $e) {
+      $transaction->rollback();
+      throw $e;
+    }
+
+  }
+
   /**
    * Deletes an item.
    * Expects the api dev to have a lock already.
@@ -140,6 +302,8 @@ class Writer implements WriterInterface {
   public function delete(PgRowInterface $obj, bool $shouldUnlock): bool {
     try {
 
+      $this->assertIsWritable($obj);
+
       $pk = $obj->getPrimaryKeyTyped();
 
       if ($pk->isDefaultValue() === true) {
@@ -166,6 +330,8 @@ class Writer implements WriterInterface {
 
         $result = $dbh->query($deleteSql);
         if ($result->wasSuccessful() === true) {
+          $pgModel->db()->pinReadsToPrimary();
+          $pgCache->invalidateProjectedRows($obj);
           if($shouldUnlock === true) {
             $pgCache->unlockRowCache($obj);
           }
@@ -180,4 +346,64 @@ class Writer implements WriterInterface {
     }
   }
 
+  /**
+   * Versioned rows skip the cache lock entirely, the update is conditional on
+   * the version we read and a miss on the row count means someone else saved
+   * first.
+   */
+  private function saveOptimistic(
+    PgRowInterface $obj,
+    bool $shouldUnlock,
+  ): bool {
+
+    $pgModel = $this->pgModel();
+    $pgCache = $pgModel->cache();
+
+    $dbh = $pgModel->db()->getWriteDatabase();
+
+    $updateSql = SqlGenerator::getUpdateSql($dbh, $pgModel, $obj);
+
+    $result = $dbh->query($updateSql);
+
+    if ($result->wasSuccessful() !== true) {
+      return false;
+    }
+
+    if ($result->getNumRows() != 1) {
+      // Whatever is cached is older than the database, drop it so the
+      // caller's reload and retry does not conflict again.
+      $pgCache->invalidateRowCache($obj);
+      throw new VersionConflictException(
+        'Row was modified by another writer version='.
+        $obj->getVersion().
+        ' obj='.
+        $obj->export()->asJSON(),
+      );
+    }
+
+    $obj->fields()->getTypedField($obj->getVersionField())
+      ->set($obj->getVersion() + 1);
+
+    $pgModel->db()->pinReadsToPrimary();
+    $pgCache->invalidateRowCache($obj);
+    $pgCache->invalidateProjectedRows($obj);
+
+    // Only does work if the caller took a lock anyway, unlock of a lock we do
+    // not own never leaves the process.
+    if ($shouldUnlock === true) {
+      $pgCache->unlockRowCache($obj);
+    }
+
+    return true;
+
+  }
+
+  private function assertIsWritable(PgRowInterface $row): void {
+    if ($row->isReadOnly() === true) {
+      throw new ReadOnlyRowException(
+        'Row is read-only row='.get_class($row),
+      );
+    }
+  }
+
 }
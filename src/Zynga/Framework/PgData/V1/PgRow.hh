@@ -10,12 +10,16 @@ use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
 
 abstract class PgRow extends StorableObject implements PgRowInterface {
   private PgModelInterface $_pgModel;
+  private ?Vector<string> $_projection;
+  private bool $_isReadOnly;
 
   public function __construct(PgModelInterface $pgModel) {
 
     parent::__construct();
 
     $this->_pgModel = $pgModel;
+    $this->_projection = null;
+    $this->_isReadOnly = false;
 
   }
 
@@ -44,6 +48,81 @@ abstract class PgRow extends StorableObject implements PgRowInterface {
 
   }
 
+  public function getProjection(): ?Vector<string> {
+    return $this->_projection;
+  }
+
+  /**
+   * Marks this row as only holding the given subset of fields. The pk is
+   * always part of the projection, and the field list is kept sorted so the
+   * same projection always produces the same checksum.
+   */
+  public function setProjection(?Vector<string> $fields): bool {
+
+    if ($fields === null) {
+      $this->_projection = null;
+      return true;
+    }
+
+    $projection = Set {$this->getPrimaryKey()};
+    $projection->addAll($fields);
+
+    $sortedFields = $projection->toValuesArray();
+    sort($sortedFields);
+
+    $this->_projection = new Vector($sortedFields);
+
+    return true;
+
+  }
+
+  /**
+   * Cache key suffix naming the projection, empty for full rows.
+   */
+  public function getProjectionChecksum(): string {
+
+    $projection = $this->_projection;
+
+    if ($projection === null) {
+      return '';
+    }
+
+    return ':p'.md5(implode(',', $projection));
+
+  }
+
+  // Partially hydrated rows cannot be written back, they would null out the
+  // fields that were not selected.
+  public function isReadOnly(): bool {
+    return $this->_isReadOnly === true || $this->_projection !== null;
+  }
+
+  public function setIsReadOnly(bool $isReadOnly): bool {
+    $this->_isReadOnly = $isReadOnly;
+    return true;
+  }
+
+  /**
+   * Name of an integer column bumped on every save. When set, saves are
+   * optimistic: the update only applies if the stored version still matches
+   * and no cache lock is needed. Empty string keeps the locked save path.
+   */
+  public function getVersionField(): string {
+    return '';
+  }
+
+  public function getVersion(): int {
+
+    $versionField = $this->getVersionField();
+
+    if ($versionField === '') {
+      return 0;
+    }
+
+    return intval($this->fields()->getTypedField($versionField)->get());
+
+  }
+
   public function save(bool $shouldUnlock = true): bool {
     return $this->pgModel()->writer()->save($this, $shouldUnlock);
   }
@@ -133,12 +133,22 @@ class PgWhereClause implements PgWhereClauseInterface {
 
     foreach ($this->_pragmas as $pragma) {
 
+      $value = $pragma->getValue();
+
+      if ($value instanceof Traversable) {
+        $valueParts = Vector {};
+        foreach ($value as $item) {
+          $valueParts->add(strval($item));
+        }
+        $value = implode(',', $valueParts);
+      }
+
       $params .=
         $pragma->getField().
         '|'.
         $pragma->getOperand().
         '|'.
-        strval($pragma->getValue()).
+        strval($value).
         "\n";
 
     }
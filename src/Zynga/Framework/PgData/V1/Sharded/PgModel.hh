@@ -4,12 +4,17 @@ namespace Zynga\Framework\PgData\V1\Sharded;
 
 use Zynga\Framework\PgData\V1\PgModel as PgModelBase;
 use Zynga\Framework\PgData\V1\Interfaces\PgModel\DbInterface;
+use
+  Zynga\Framework\PgData\V1\Interfaces\Sharded\PgModel\ScatterGatherInterface
+;
 use Zynga\Framework\PgData\V1\Interfaces\Sharded\PgModelInterface;
 use Zynga\Framework\PgData\V1\Sharded\PgModel\Db;
+use Zynga\Framework\PgData\V1\Sharded\PgModel\ScatterGather;
 use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
 
 abstract class PgModel extends PgModelBase implements PgModelInterface {
   private TypeInterface $_shardId;
+  private ?ScatterGatherInterface $_scatterGather = null;
 
   public function __construct(TypeInterface $shardId) {
     $this->_shardId = $shardId;
@@ -24,4 +29,24 @@ abstract class PgModel extends PgModelBase implements PgModelInterface {
     return new Db($this, $this->getShardId());
   }
 
+  public function createScatterGatherObject(): ScatterGatherInterface {
+    return new ScatterGather($this);
+  }
+
+  final public function scatterGather(): ScatterGatherInterface {
+
+    $scatterGather = $this->_scatterGather;
+
+    if ($scatterGather instanceof ScatterGatherInterface) {
+      return $scatterGather;
+    }
+
+    $scatterGather = $this->createScatterGatherObject();
+
+    $this->_scatterGather = $scatterGather;
+
+    return $scatterGather;
+
+  }
+
 }
@@ -47,6 +47,15 @@ class Db implements DbInterface {
     }
   }
 
+  public function releaseReadDatabase(QueryableInterface $dbh): bool {
+    // Shards have a single handle, nothing to route.
+    return true;
+  }
+
+  public function pinReadsToPrimary(): bool {
+    return true;
+  }
+
   public function getWriteDatabase(): QueryableInterface {
     try {
       $pgModel = $this->pgModel();
@@ -67,6 +76,13 @@ class Db implements DbInterface {
       return $dbh->quote()->floatValue($value);
     } else if (is_int($value)) {
       return $dbh->quote()->intValue($value);
+    } else if ($value instanceof Traversable) {
+      // Lists are rendered as a parenthesized set for IN / NOT IN clauses.
+      $quotedValues = Vector {};
+      foreach ($value as $item) {
+        $quotedValues->add($this->quoteValue($dbh, $item));
+      }
+      return '('.implode(',', $quotedValues).')';
     }
 
     throw new UnsupportedValueTypeException('value='.gettype($value));
@@ -0,0 +1,267 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\Sharded\PgModel;
+
+use Zynga\Framework\Exception\V1\Exception;
+use
+  Zynga\Framework\PgData\V1\Exceptions\FailedToFindFieldOnObjectException
+;
+use Zynga\Framework\PgData\V1\Interfaces\PgModelInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgResultSetInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
+use Zynga\Framework\PgData\V1\Interfaces\PgWhereClauseInterface;
+use
+  Zynga\Framework\PgData\V1\Interfaces\Sharded\PgModel\ScatterGatherInterface
+;
+use Zynga\Framework\PgData\V1\PgModel\SqlGenerator;
+use Zynga\Framework\PgData\V1\PgResultSet;
+use Zynga\Framework\PgData\V1\PgWhereClause;
+use Zynga\Framework\ShardedDatabase\V3\Driver\AsyncMysql;
+use
+  Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverInterface as ShardedDriverInterface
+;
+
+/**
+ * Runs the same where clause against every shard (or a subset of them)
+ * concurrently and merges the rows back into a single result set.
+ *
+ * The fan out is the read driver's genQueryAllShards(). Only the AsyncMysql
+ * driver runs the shards concurrently, over its own connections, so the wall
+ * time is the slowest shard rather than the sum of all of them. Every other
+ * driver (GenericPDO, Mock) falls back to Base::genQueryAllShards(), which
+ * blocks on one shard after the other: the merge, ordering, limit and per
+ * shard latencies still work, but the wall time is the sum of the shards.
+ * Point the model's read database at an AsyncMysql config to get the
+ * concurrent fan out. Rows returned
+ * are read-only as the model they are attached to is not bound to the shard
+ * they came from, re-fetch through a shard bound model before writing.
+ */
+class ScatterGather implements ScatterGatherInterface {
+  const int DEFAULT_TIMEOUT_MICROS = 5000000;
+
+  private PgModelInterface $_pgModel;
+  private Map<int, float> $_shardLatencies;
+  private int $_timeoutMicros;
+
+  public function __construct(PgModelInterface $pgModel) {
+    $this->_pgModel = $pgModel;
+    $this->_shardLatencies = Map {};
+    $this->_timeoutMicros = self::DEFAULT_TIMEOUT_MICROS;
+  }
+
+  private function pgModel(): PgModelInterface {
+    return $this->_pgModel;
+  }
+
+  public function getTimeoutMicros(): int {
+    return $this->_timeoutMicros;
+  }
+
+  public function setTimeoutMicros(int $timeoutMicros): bool {
+    $this->_timeoutMicros = $timeoutMicros;
+    return true;
+  }
+
+  /**
+   * Latency in milliseconds per shard index for the last get() call.
+   */
+  public function getShardLatencies(): Map<int, float> {
+    return $this->_shardLatencies;
+  }
+
+  public function get<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    ?PgWhereClauseInterface $where = null,
+    ?Vector<int> $shardIndexes = null,
+    string $orderBy = '',
+    bool $orderAscending = true,
+    int $limit = 0,
+  ): PgResultSetInterface<PgRowInterface> {
+    try {
+      return \HH\Asio\join(
+        $this->genGet(
+          $model,
+          $where,
+          $shardIndexes,
+          $orderBy,
+          $orderAscending,
+          $limit,
+        ),
+      );
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
+  public async function genGet<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    ?PgWhereClauseInterface $where = null,
+    ?Vector<int> $shardIndexes = null,
+    string $orderBy = '',
+    bool $orderAscending = true,
+    int $limit = 0,
+  ): Awaitable<PgResultSetInterface<PgRowInterface>> {
+
+    // 0) Snag a reference to our pgModel
+    $pgModel = $this->pgModel();
+
+    // 1) Make a where if they didn't provide one.
+    if ($where === null) {
+      $where = new PgWhereClause($pgModel);
+    }
+
+    // 2) The read handle gives us the quoting, the shard layout and the fan
+    //    out itself.
+    $dbh = $pgModel->db()->getReadDatabase();
+
+    try {
+
+      if (!$dbh instanceof ShardedDriverInterface) {
+        throw new Exception(
+          'ScatterGather requires a sharded read database model='.
+          get_class($pgModel),
+        );
+      }
+
+      if ($dbh instanceof AsyncMysql) {
+        $dbh->setShardTimeoutMicros($this->_timeoutMicros);
+      }
+
+      // 3) One sql statement for every shard, each shard only needs to return
+      //    its own top $limit rows for the merge to be correct.
+      $tobj = $pgModel->data()->createRowObjectFromClassName($model);
+
+      $sql =
+        SqlGenerator::getSelectSql($dbh, $pgModel, $tobj, $where).
+        $this->createOrderAndLimitSql($tobj, $orderBy, $orderAscending, $limit);
+
+      // 4) The driver runs the shards, concurrently and over pooled
+      //    connections where it can.
+      $this->_shardLatencies->clear();
+
+      $shardResults = await $dbh->genQueryAllShards($sql, $shardIndexes);
+
+      $this->_shardLatencies->setAll($dbh->getShardLatencies());
+
+    } finally {
+      $pgModel->db()->releaseReadDatabase($dbh);
+    }
+
+    $pgModel->stats()->incrementSqlSelects();
+
+    // 5) Hydrate the rows for each shard.
+    $rowsByShard = Vector {};
+
+    foreach ($shardResults as $shardIndex => $resultSet) {
+
+      $rows = Vector {};
+
+      while ($resultSet->hasMore() === true && $resultSet->next() === true) {
+        $obj = $pgModel->data()->createRowObjectFromClassName($model);
+        $pgModel->data()->hydrateDataToRowObject($obj, $resultSet->fetchMap());
+        $obj->setIsReadOnly(true);
+        $rows->add($obj);
+      }
+
+      $rowsByShard->add($rows);
+
+    }
+
+    return
+      $this->mergeResults(
+        $model,
+        $rowsByShard,
+        $orderBy,
+        $orderAscending,
+        $limit,
+      );
+
+  }
+
+  /**
+   * Merges the per shard rows, applying the global ordering and limit.
+   */
+  public function mergeResults<TModelClass as PgRowInterface>(
+    classname<TModelClass> $model,
+    Vector<Vector<PgRowInterface>> $rowsByShard,
+    string $orderBy,
+    bool $orderAscending,
+    int $limit,
+  ): PgResultSetInterface<PgRowInterface> {
+
+    $rows = array();
+
+    foreach ($rowsByShard as $shardRows) {
+      foreach ($shardRows as $row) {
+        $rows[] = $row;
+      }
+    }
+
+    if ($orderBy !== '') {
+      usort(
+        $rows,
+        (PgRowInterface $a, PgRowInterface $b) ==> {
+          $aValue = $a->fields()->getTypedField($orderBy)->get();
+          $bValue = $b->fields()->getTypedField($orderBy)->get();
+
+          if ($aValue == $bValue) {
+            return 0;
+          }
+
+          $cmp = ($aValue < $bValue) ? -1 : 1;
+
+          return ($orderAscending === true) ? $cmp : -$cmp;
+        },
+      );
+    }
+
+    $resultSet = new PgResultSet($model);
+
+    foreach ($rows as $row) {
+
+      if ($limit > 0 && $resultSet->count() >= $limit) {
+        break;
+      }
+
+      $resultSet->add($row);
+
+    }
+
+    return $resultSet;
+
+  }
+
+  private function createOrderAndLimitSql(
+    PgRowInterface $obj,
+    string $orderBy,
+    bool $orderAscending,
+    int $limit,
+  ): string {
+
+    $sql = '';
+
+    if ($orderBy !== '') {
+
+      // only allow real fields through, this is concatenated into the sql.
+      $fieldMap = $obj->fields()->getFieldsAndTypesForObject();
+
+      if (!$fieldMap->containsKey($orderBy)) {
+        throw new FailedToFindFieldOnObjectException(
+          'Failed to find field='.$orderBy.' on '.get_class($obj),
+        );
+      }
+
+      $sql .= ' ORDER BY '.$orderBy;
+      $sql .= ($orderAscending === true) ? ' ASC' : ' DESC';
+
+    }
+
+    if ($limit > 0) {
+      $sql .= ' LIMIT '.$limit;
+    }
+
+    return $sql;
+
+  }
+
+}
@@ -0,0 +1,143 @@
+<?hh // strict
+
+namespace Zynga\Framework\PgData\V1\Sharded\PgModel;
+
+use Zynga\Framework\PgData\V1\Interfaces\PgRowInterface;
+use Zynga\Framework\PgData\V1\Sharded\PgModel as ShardedPgModel;
+use Zynga\Framework\PgData\V1\Sharded\PgModel\ScatterGather;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\InventoryModel;
+use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\Inventory\ItemType;
+use Zynga\Framework\ShardedDatabase\V3\Driver\Mock as MockDriver;
+use Zynga\Framework\ShardedDatabase\V3\Factory as DatabaseFactory;
+use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverInterface;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+use Zynga\Framework\Type\V1\UInt64Box;
+
+class ScatterGatherMockModel extends ShardedPgModel {
+
+  public function getDataCacheName(): string {
+    return 'PgDataTest';
+  }
+
+  public function getResultSetCacheName(): string {
+    return 'PgResultSetTest';
+  }
+
+  public function getReadDatabaseName(): string {
+    return 'Mock';
+  }
+
+  public function getWriteDatabaseName(): string {
+    return 'Mock';
+  }
+
+}
+
+class ScatterGatherTest extends TestCase {
+
+  private function createShardRows(
+    InventoryModel $model,
+    Vector<int> $ids,
+  ): Vector<PgRowInterface> {
+    $rows = Vector {};
+    foreach ($ids as $id) {
+      $item = new ItemType($model);
+      $item->id->set($id);
+      $item->name->set('item-'.$id);
+      $rows->add($item);
+    }
+    return $rows;
+  }
+
+  public function testMergeResults_OrderAndLimit(): void {
+
+    $model = new InventoryModel();
+    $scatterGather = new ScatterGather($model);
+
+    $rowsByShard = Vector {
+      $this->createShardRows($model, Vector {1, 4, 7}),
+      $this->createShardRows($model, Vector {2, 5}),
+      $this->createShardRows($model, Vector {3, 6, 8}),
+    };
+
+    $resultSet =
+      $scatterGather->mergeResults(ItemType::class, $rowsByShard, 'id', false, 4);
+
+    $this->assertEquals(4, $resultSet->count());
+
+    $ids = Vector {};
+    foreach ($resultSet->toArray() as $row) {
+      $ids->add($row->getPrimaryKeyTyped()->get());
+    }
+
+    $this->assertEquals(Vector {8, 7, 6, 5}, $ids);
+
+  }
+
+  public function testMergeResults_Unordered(): void {
+
+    $model = new InventoryModel();
+    $scatterGather = new ScatterGather($model);
+
+    $rowsByShard = Vector {
+      $this->createShardRows($model, Vector {1, 4}),
+      $this->createShardRows($model, Vector {2}),
+    };
+
+    $resultSet =
+      $scatterGather->mergeResults(ItemType::class, $rowsByShard, '', true, 0);
+
+    $this->assertEquals(3, $resultSet->count());
+
+  }
+
+  public function testTimeoutMicros(): void {
+    $scatterGather = new ScatterGather(new InventoryModel());
+    $this->assertEquals(
+      ScatterGather::DEFAULT_TIMEOUT_MICROS,
+      $scatterGather->getTimeoutMicros(),
+    );
+    $this->assertTrue($scatterGather->setTimeoutMicros(1000));
+    $this->assertEquals(1000, $scatterGather->getTimeoutMicros());
+    $this->assertEquals(0, $scatterGather->getShardLatencies()->count());
+  }
+
+  public function testGet_MockDriver(): void {
+
+    $dbh = DatabaseFactory::factory(DriverInterface::class, 'Mock');
+
+    if (!$dbh instanceof MockDriver) {
+      $this->fail('Mock config should hand back the mock driver');
+      return;
+    }
+
+    $dbh->resetResultsSets();
+    $dbh->addResultSet(
+      Vector {
+        Map {'id' => 3, 'name' => 'item-3'},
+        Map {'id' => 1, 'name' => 'item-1'},
+        Map {'id' => 2, 'name' => 'item-2'},
+      },
+    );
+
+    $model = new ScatterGatherMockModel(new UInt64Box(1));
+
+    $resultSet = $model->scatterGather()
+      ->get(ItemType::class, null, Vector {0}, 'id', true, 2);
+
+    $this->assertEquals(2, $resultSet->count());
+
+    $ids = Vector {};
+    foreach ($resultSet->toArray() as $row) {
+      $this->assertTrue($row->isReadOnly());
+      $ids->add($row->getPrimaryKeyTyped()->get());
+    }
+
+    $this->assertEquals(Vector {1, 2}, $ids);
+    $this->assertTrue(
+      $model->scatterGather()->getShardLatencies()->containsKey(0),
+    );
+
+  }
+
+}
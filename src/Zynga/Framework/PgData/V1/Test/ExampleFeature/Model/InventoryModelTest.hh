@@ -9,11 +9,17 @@ use Zynga\Framework\Lockable\Cache\V1\Factory as LockableCacheFactory;
 use
   Zynga\Framework\Lockable\Cache\V1\Interfaces\DriverInterface as LockableCacheDriverInterface
 ;
+use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\PgData\V1\Exceptions\InvalidPrimaryKeyValueException;
+use Zynga\Framework\PgData\V1\Exceptions\ReadOnlyRowException;
+use Zynga\Framework\PgData\V1\Exceptions\VersionConflictException;
 use Zynga\Framework\PgData\V1\Interfaces\PgWhereClauseInterface;
 use Zynga\Framework\PgData\V1\PgModel;
 use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\InventoryModel;
 use Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\Inventory\ItemType;
+use
+  Zynga\Framework\PgData\V1\Test\ExampleFeature\Model\Inventory\VersionedItemType
+;
 use Zynga\Framework\PgData\V1\PgWhereClause;
 use Zynga\Framework\PgData\V1\PgWhereOperand;
 
@@ -192,6 +198,55 @@ class InventoryModelTest extends BaseInventoryTest {
 
   }
 
+  public function testInventory_Projection(): void {
+
+    $model = new InventoryModel();
+
+    $where = new PgWhereClause($model);
+    $where->and('name', PgWhereOperand::EQUALS, 'this-is-a-test-valueset-3');
+
+    $resultSet = $model->get(ItemType::class, $where, Vector {'id'});
+    $this->assertEquals(1, $resultSet->count());
+
+    $row = $resultSet->at(0);
+
+    if ($row instanceof ItemType) {
+      $this->assertEquals(12387453, $row->id->get());
+      $this->assertEquals('', $row->name->get());
+      $this->assertTrue($row->isReadOnly());
+      $this->assertEquals(Vector {'id'}, $row->getProjection());
+    } else {
+      $this->fail('type returned should of been ItemType');
+    }
+
+    // A repeat read is served from the projection cache.
+    $selects = $model->stats()->getSqlSelects();
+    $again = $model->get(ItemType::class, $where, Vector {'id'});
+    $this->assertEquals(1, $again->count());
+    $this->assertEquals($selects, $model->stats()->getSqlSelects());
+
+    // The full row must not have been replaced by the projected one.
+    $fullRow = $model->getByPk(ItemType::class, 12387453, true);
+
+    if ($fullRow instanceof ItemType) {
+      $this->assertEquals('this-is-a-test-valueset-3', $fullRow->name->get());
+      $this->assertFalse($fullRow->isReadOnly());
+      // Saving the row drops its cached projections.
+      $this->assertTrue($fullRow->save(true));
+    } else {
+      $this->fail('type returned should of been ItemType');
+    }
+
+    $selects = $model->stats()->getSqlSelects();
+    $afterSave = $model->get(ItemType::class, $where, Vector {'id'});
+    $this->assertEquals(1, $afterSave->count());
+    $this->assertEquals($selects + 1, $model->stats()->getSqlSelects());
+
+    $this->expectException(ReadOnlyRowException::class);
+    $row->save();
+
+  }
+
   public function testInventory_IdIncrementing(): void {
 
     // stand up the model
@@ -289,6 +344,205 @@ class InventoryModelTest extends BaseInventoryTest {
 
   }
 
+  public function testInventory_SaveAll(): void {
+
+    $model = new InventoryModel();
+
+    $items = Vector {};
+
+    for ($i = 0; $i < 3; $i++) {
+      $item = new ItemType($model);
+      $item->name->set('this-is-a-phpunit-test-'.$i.'-'.time().'-'.mt_rand(200));
+      $this->assertTrue($model->add($item, true));
+      $items->add($item);
+    }
+
+    foreach ($items as $offset => $item) {
+      $item->name->set('this-is-a-saveall-test-'.$offset.'-'.time());
+      $this->assertTrue($model->lockRowCache($item));
+    }
+
+    $this->assertTrue($model->saveAll($items, true));
+
+    // Nothing to batch.
+    $this->assertTrue($model->saveAll(Vector {}, true));
+
+  }
+
+  public function testInventory_SaveAll_RequiresLock(): void {
+
+    $model = new InventoryModel();
+
+    $item = new ItemType($model);
+    $item->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+    $this->assertTrue($model->add($item, true));
+
+    $this->expectException(Exception::class);
+    $model->saveAll(Vector {$item}, true);
+
+  }
+
+  public function testInventory_SaveAll_VersionConflictRollsBack(): void {
+
+    $model = new InventoryModel();
+
+    $item = new ItemType($model);
+    $item->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+    $this->assertTrue($model->add($item, true));
+
+    $versioned = new VersionedItemType($model);
+    $versioned->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+    $this->assertTrue($model->add($versioned, true));
+
+    // Read at the same version, then lose the race to another writer.
+    $staleItem = new VersionedItemType($model);
+    $staleItem->id->set($versioned->id->get());
+    $staleItem->name->set($versioned->name->get());
+    $staleItem->version->set($versioned->version->get());
+
+    $this->assertTrue($versioned->save(true));
+
+    $newName = 'this-is-a-saveall-conflict-test-'.time().'-'.mt_rand(200);
+    $item->name->set($newName);
+    $this->assertTrue($model->lockRowCache($item));
+
+    try {
+      $model->saveAll(Vector {$item, $staleItem}, true);
+      $this->fail('stale versioned row should fail the batch');
+    } catch (VersionConflictException $e) {
+      // expected
+    }
+
+    // The unversioned row went in the same transaction, it was rolled back.
+    $where = new PgWhereClause($model);
+    $where->and('name', PgWhereOperand::EQUALS, $newName);
+    $this->assertEquals(
+      0,
+      $model->get(ItemType::class, $where, Vector {'id'})->count(),
+    );
+
+  }
+
+  public function testInventory_SaveOptimistic(): void {
+
+    $model = new InventoryModel();
+
+    $item = new VersionedItemType($model);
+    $item->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+
+    $this->assertTrue($model->add($item, true));
+    $this->assertEquals(0, $item->getVersion());
+
+    // No lock taken, the version guards the update.
+    $item->name->set('this-is-another-phpunit-test-'.time().'-'.mt_rand(200));
+    $this->assertTrue($item->save(true));
+    $this->assertEquals(1, $item->getVersion());
+
+    $this->assertTrue($item->save(true));
+    $this->assertEquals(2, $item->getVersion());
+
+  }
+
+  public function testInventory_SaveOptimistic_Conflict(): void {
+
+    $model = new InventoryModel();
+
+    $item = new VersionedItemType($model);
+    $item->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+
+    $this->assertTrue($model->add($item, true));
+
+    // A second copy read at the same version as the first.
+    $staleItem = new VersionedItemType($model);
+    $staleItem->id->set($item->id->get());
+    $staleItem->name->set($item->name->get());
+    $staleItem->version->set($item->version->get());
+
+    $this->assertTrue($item->save(true));
+
+    $this->expectException(VersionConflictException::class);
+    $staleItem->save(true);
+
+  }
+
+  public function testInventory_SaveOptimistic_InterleavedWriters(): void {
+
+    $model = new InventoryModel();
+    $cache = $model->cache()->getDataCache()->getConfig()->getCache();
+
+    $item = new VersionedItemType($model);
+    $item->name->set('this-is-a-phpunit-test-'.time().'-'.mt_rand(200));
+
+    $this->assertTrue($model->add($item, true));
+
+    $id = $item->id->get();
+
+    // Writer A and writer B both load the row before either one saves. The
+    // in memory cache hands back the instance it holds, B reads from the
+    // database like another process would so it gets its own copy.
+    $writerA = $model->getByPk(VersionedItemType::class, $id, false);
+
+    if (!$writerA instanceof VersionedItemType) {
+      $this->fail('type returned should of been VersionedItemType');
+      return;
+    }
+
+    $model->cache()->invalidateRowCache($writerA);
+
+    $writerB = $model->getByPk(VersionedItemType::class, $id, false);
+
+    if (!$writerB instanceof VersionedItemType || $writerB === $writerA) {
+      $this->fail('type returned should of been VersionedItemType');
+      return;
+    }
+
+    $this->assertEquals(0, $writerA->getVersion());
+    $this->assertEquals(0, $writerB->getVersion());
+
+    $writerA->name->set('writer-a');
+    $this->assertTrue($writerA->save(true));
+
+    // A reader that raced A's save put the old row back in cache.
+    $cache->set($writerB);
+
+    $writerB->name->set('writer-b');
+
+    try {
+      $writerB->save(true);
+      $this->fail('B saved over A with a stale version');
+    } catch (VersionConflictException $e) {
+      // expected
+    }
+
+    // The conflict dropped the stale copy, B's reload sees A's write.
+    $probe = new VersionedItemType($model);
+    $probe->id->set($id);
+    $this->assertEquals(null, $cache->get($probe));
+
+    $retry = $model->getByPk(VersionedItemType::class, $id, false);
+
+    if (!$retry instanceof VersionedItemType) {
+      $this->fail('type returned should of been VersionedItemType');
+      return;
+    }
+
+    $this->assertEquals(1, $retry->getVersion());
+    $this->assertEquals('writer-a', $retry->name->get());
+
+    $retry->name->set('writer-b');
+    $this->assertTrue($retry->save(true));
+
+    $fresh = $model->getByPk(VersionedItemType::class, $id, false);
+
+    if ($fresh instanceof VersionedItemType) {
+      $this->assertEquals(2, $fresh->getVersion());
+      $this->assertEquals('writer-b', $fresh->name->get());
+    } else {
+      $this->fail('type returned should of been VersionedItemType');
+    }
+
+  }
+
   private function doesQueryReturnExpectedValues(
     Vector<Map<string, mixed>> $expectedResultToInclude,
     ?PgWhereClauseInterface $where = null,
@@ -0,0 +1,247 @@
+<?hh //strict
+
+namespace Zynga\Framework\ShardedDatabase\V3;
+
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidBucketException;
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidShardIdException;
+
+/**
+ * Fixed set of virtual buckets mapped onto physical server offsets. Shard
+ * values hash to a bucket, and only the bucket -> server table changes when
+ * capacity is added, so growing the cluster moves whole buckets rather than
+ * reshuffling every user.
+ *
+ * A bucket that is being moved points at its new server for writes and
+ * remembers the server it came from, drivers read from the new server first
+ * and fall back to the old one until the move is completed.
+ */
+class BucketMap {
+  private int $_bucketCount;
+  private Vector<int> $_buckets;
+  private Map<int, int> $_migrating;
+
+  public function __construct(int $bucketCount) {
+
+    if ($bucketCount < 1) {
+      throw new InvalidBucketException('bucketCount='.$bucketCount);
+    }
+
+    $this->_bucketCount = $bucketCount;
+    $this->_buckets = Vector {};
+    $this->_buckets->resize($bucketCount, 0);
+    $this->_migrating = Map {};
+
+  }
+
+  public function getBucketCount(): int {
+    return $this->_bucketCount;
+  }
+
+  public function getBucketForValue(int $value): int {
+    return abs($value % $this->_bucketCount);
+  }
+
+  public function getServer(int $bucket): int {
+    $this->assertValidBucket($bucket);
+    return $this->_buckets[$bucket];
+  }
+
+  public function assign(int $bucket, int $server): bool {
+    $this->assertValidBucket($bucket);
+    $this->assertValidServer($server);
+    $this->_buckets[$bucket] = $server;
+    return true;
+  }
+
+  /**
+   * Loads the table in one go, typically from wherever the cluster layout is
+   * persisted. Keys are buckets, values are server offsets. In flight moves
+   * are persisted separately, see loadMoves().
+   */
+  public function load(KeyedTraversable<int, int> $table): bool {
+    foreach ($table as $bucket => $server) {
+      $this->assign($bucket, $server);
+    }
+    return true;
+  }
+
+  public function toVector(): Vector<int> {
+    return $this->_buckets->toVector();
+  }
+
+  public function getBucketsForServer(int $server): Vector<int> {
+    $buckets = Vector {};
+    foreach ($this->_buckets as $bucket => $bucketServer) {
+      if ($bucketServer == $server) {
+        $buckets->add($bucket);
+      }
+    }
+    return $buckets;
+  }
+
+  /**
+   * Points the bucket at its new server and keeps the old one around for
+   * reads. Returns false if the bucket already lives there.
+   */
+  public function beginMove(int $bucket, int $toServer): bool {
+
+    $this->assertValidBucket($bucket);
+    $this->assertValidServer($toServer);
+
+    $fromServer = $this->_buckets[$bucket];
+
+    if ($fromServer == $toServer) {
+      return false;
+    }
+
+    // A second move keeps the original source, that is where the rows are.
+    if (!$this->_migrating->containsKey($bucket)) {
+      $this->_migrating->set($bucket, $fromServer);
+    }
+
+    $this->_buckets[$bucket] = $toServer;
+
+    return true;
+
+  }
+
+  /**
+   * Called once the rows for the bucket have been copied to the new server.
+   */
+  public function completeMove(int $bucket): bool {
+    $this->assertValidBucket($bucket);
+    if (!$this->_migrating->containsKey($bucket)) {
+      return false;
+    }
+    $this->_migrating->remove($bucket);
+    return true;
+  }
+
+  public function abortMove(int $bucket): bool {
+
+    $this->assertValidBucket($bucket);
+
+    $fromServer = $this->_migrating->get($bucket);
+
+    if ($fromServer === null) {
+      return false;
+    }
+
+    $this->_buckets[$bucket] = $fromServer;
+    $this->_migrating->remove($bucket);
+
+    return true;
+
+  }
+
+  /**
+   * Restores in flight moves, keys are buckets, values are the server the
+   * bucket is moving off of. Load the table first, the bucket should already
+   * point at its new server. Every process has to load the same moves from
+   * the shared layout or it will not see the dual read window.
+   */
+  public function loadMoves(KeyedTraversable<int, int> $moves): bool {
+    foreach ($moves as $bucket => $fromServer) {
+      $this->assertValidBucket($bucket);
+      $this->assertValidServer($fromServer);
+      if ($this->_buckets[$bucket] == $fromServer) {
+        throw new InvalidBucketException(
+          'bucket='.$bucket.' is already on server='.$fromServer,
+        );
+      }
+      $this->_migrating->set($bucket, $fromServer);
+    }
+    return true;
+  }
+
+  public function isMigrating(int $bucket): bool {
+    return $this->_migrating->containsKey($bucket);
+  }
+
+  public function getMigrationSource(int $bucket): ?int {
+    return $this->_migrating->get($bucket);
+  }
+
+  public function getMigratingBuckets(): Map<int, int> {
+    return $this->_migrating->toMap();
+  }
+
+  /**
+   * Works out the smallest set of bucket moves that spreads the buckets
+   * evenly over $serverCount servers. Returns bucket => target server, feed
+   * each entry to beginMove() when ready to migrate it.
+   */
+  public function planRebalance(int $serverCount): Map<int, int> {
+
+    if ($serverCount < 1) {
+      throw new InvalidShardIdException('serverCount='.$serverCount);
+    }
+
+    $base = intdiv($this->_bucketCount, $serverCount);
+    $extra = $this->_bucketCount % $serverCount;
+
+    $bucketsByServer = Map {};
+    for ($server = 0; $server < $serverCount; $server++) {
+      $bucketsByServer->set($server, Vector {});
+    }
+
+    // Buckets on servers that are going away always have to move.
+    $surplus = Vector {};
+
+    foreach ($this->_buckets as $bucket => $server) {
+      $serverBuckets = $bucketsByServer->get($server);
+      if ($serverBuckets === null) {
+        $surplus->add($bucket);
+      } else {
+        $serverBuckets->add($bucket);
+      }
+    }
+
+    // Servers already holding the most keep the larger quota.
+    $order = $bucketsByServer->keys()->toArray();
+    usort(
+      $order,
+      (int $a, int $b) ==> {
+        $diff = $bucketsByServer[$b]->count() - $bucketsByServer[$a]->count();
+        return ($diff != 0) ? $diff : $a - $b;
+      },
+    );
+
+    $quota = Map {};
+    foreach ($order as $offset => $server) {
+      $quota->set($server, $base + (($offset < $extra) ? 1 : 0));
+    }
+
+    foreach ($bucketsByServer as $server => $serverBuckets) {
+      while ($serverBuckets->count() > $quota[$server]) {
+        $surplus->add($serverBuckets->pop());
+      }
+    }
+
+    $moves = Map {};
+
+    foreach ($bucketsByServer as $server => $serverBuckets) {
+      $needed = $quota[$server] - $serverBuckets->count();
+      while ($needed > 0 && $surplus->count() > 0) {
+        $moves->set($surplus->pop(), $server);
+        $needed--;
+      }
+    }
+
+    return $moves;
+
+  }
+
+  private function assertValidBucket(int $bucket): void {
+    if ($bucket < 0 || $bucket >= $this->_bucketCount) {
+      throw new InvalidBucketException('bucket='.$bucket);
+    }
+  }
+
+  private function assertValidServer(int $server): void {
+    if ($server < 0) {
+      throw new InvalidShardIdException('server='.$server);
+    }
+  }
+
+}
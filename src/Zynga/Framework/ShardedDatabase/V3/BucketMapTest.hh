@@ -0,0 +1,172 @@
+<?hh //strict
+
+namespace Zynga\Framework\ShardedDatabase\V3;
+
+use Zynga\Framework\ShardedDatabase\V3\BucketMap;
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidBucketException;
+use
+  Zynga\Framework\ShardedDatabase\V3\Test\UserSharded\Config\Mock\Base\VirtualBuckets
+;
+use
+  Zynga\Framework\ShardedDatabase\V3\Test\UserSharded\Config\Mock\Base\VirtualBucketsMigrating
+;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+use Zynga\Framework\Type\V1\UInt64Box;
+
+class BucketMapTest extends TestCase {
+
+  private function createMap(int $bucketCount, int $serverCount): BucketMap {
+    $map = new BucketMap($bucketCount);
+    for ($bucket = 0; $bucket < $bucketCount; $bucket++) {
+      $map->assign($bucket, $bucket % $serverCount);
+    }
+    return $map;
+  }
+
+  public function testInvalidBucketCount(): void {
+    $this->expectException(InvalidBucketException::class);
+    new BucketMap(0);
+  }
+
+  public function testInvalidBucket(): void {
+    $map = new BucketMap(4);
+    $this->expectException(InvalidBucketException::class);
+    $map->getServer(4);
+  }
+
+  public function testMoveLifecycle(): void {
+
+    $map = $this->createMap(8, 2);
+
+    $this->assertFalse($map->beginMove(0, 0));
+
+    $this->assertTrue($map->beginMove(0, 1));
+    $this->assertEquals(1, $map->getServer(0));
+    $this->assertTrue($map->isMigrating(0));
+    $this->assertEquals(0, $map->getMigrationSource(0));
+
+    $this->assertTrue($map->abortMove(0));
+    $this->assertEquals(0, $map->getServer(0));
+    $this->assertFalse($map->isMigrating(0));
+
+    $this->assertTrue($map->beginMove(0, 1));
+    $this->assertTrue($map->completeMove(0));
+    $this->assertEquals(1, $map->getServer(0));
+    $this->assertEquals(null, $map->getMigrationSource(0));
+    $this->assertFalse($map->completeMove(0));
+
+  }
+
+  public function testPlanRebalance_AddServer(): void {
+
+    $map = $this->createMap(64, 2);
+
+    $moves = $map->planRebalance(3);
+
+    // Only the new server's share moves, nothing is shuffled between the
+    // existing servers.
+    $this->assertEquals(21, $moves->count());
+
+    foreach ($moves as $bucket => $server) {
+      $this->assertEquals(2, $server);
+      $this->assertTrue($map->beginMove($bucket, $server));
+    }
+
+    $this->assertEquals(22, $map->getBucketsForServer(0)->count());
+    $this->assertEquals(21, $map->getBucketsForServer(1)->count());
+    $this->assertEquals(21, $map->getBucketsForServer(2)->count());
+
+    $this->assertEquals(0, $map->planRebalance(3)->count());
+
+  }
+
+  public function testConfig_VirtualBuckets(): void {
+
+    $config = new VirtualBuckets();
+
+    $bucketMap = $config->getBucketMap();
+
+    if ($bucketMap === null) {
+      $this->fail('bucket map should be set up');
+      return;
+    }
+
+    $this->assertEquals(VirtualBuckets::BUCKET_COUNT, $bucketMap->getBucketCount());
+
+    $shardType = new UInt64Box(67);
+    $bucket = $bucketMap->getBucketForValue(67);
+
+    $this->assertEquals(3, $bucket);
+    $this->assertEquals(1, $config->getShardId($shardType));
+    $this->assertEquals(null, $config->getFallbackShardId($shardType));
+
+    $bucketMap->beginMove($bucket, 0);
+
+    $this->assertEquals(0, $config->getShardId($shardType));
+    $this->assertEquals(1, $config->getFallbackShardId($shardType));
+
+  }
+
+  public function testLoadMoves_SecondMapSharesState(): void {
+
+    $map = $this->createMap(8, 2);
+    $this->assertTrue($map->beginMove(3, 0));
+
+    // What another worker would build from the persisted layout.
+    $other = new BucketMap(8);
+    $this->assertTrue($other->load($map->toVector()));
+    $this->assertTrue($other->loadMoves($map->getMigratingBuckets()));
+
+    $this->assertEquals($map->toVector(), $other->toVector());
+    $this->assertEquals(
+      $map->getMigratingBuckets(),
+      $other->getMigratingBuckets(),
+    );
+    $this->assertTrue($other->isMigrating(3));
+    $this->assertEquals(1, $other->getMigrationSource(3));
+    $this->assertEquals(0, $other->getServer(3));
+
+    $this->assertTrue($other->completeMove(3));
+    $this->assertFalse($other->isMigrating(3));
+
+  }
+
+  public function testLoadMoves_AlreadyOnServer(): void {
+    $map = $this->createMap(8, 2);
+    $this->expectException(InvalidBucketException::class);
+    $map->loadMoves(Map {3 => 1});
+  }
+
+  public function testConfig_MovesFromConfig(): void {
+
+    // Separate config instances stand in for separate workers.
+    foreach (Vector {
+               new VirtualBucketsMigrating(),
+               new VirtualBucketsMigrating(),
+             } as $config) {
+
+      $bucketMap = $config->getBucketMap();
+
+      if ($bucketMap === null) {
+        $this->fail('bucket map should be set up');
+        return;
+      }
+
+      $this->assertTrue(
+        $bucketMap->isMigrating(VirtualBucketsMigrating::MOVING_BUCKET),
+      );
+
+      // 67 lands in the moving bucket, 65 stays put on the same source server.
+      $this->assertEquals(0, $config->getShardId(new UInt64Box(67)));
+      $this->assertEquals(1, $config->getFallbackShardId(new UInt64Box(67)));
+      $this->assertEquals(1, $config->getShardId(new UInt64Box(65)));
+      $this->assertEquals(
+        null,
+        $config->getFallbackShardId(new UInt64Box(65)),
+      );
+
+    }
+
+  }
+
+}
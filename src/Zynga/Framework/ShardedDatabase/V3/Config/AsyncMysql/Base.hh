@@ -0,0 +1,14 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Config\AsyncMysql;
+
+use Zynga\Framework\ShardedDatabase\V3\Config\Mysql\Base as MysqlBase;
+use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
+
+abstract class Base<TType as TypeInterface> extends MysqlBase<TType> {
+
+  public function getDriver(): string {
+    return 'AsyncMysql';
+  }
+
+}
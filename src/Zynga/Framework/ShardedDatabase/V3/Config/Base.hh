@@ -13,6 +13,7 @@ use
   Zynga\Framework\ShardedDatabase\V3\Exceptions\ShardsInitNoServersException
 ;
 use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverConfigInterface;
+use Zynga\Framework\ShardedDatabase\V3\BucketMap;
 use Zynga\Framework\ShardedDatabase\V3\ConnectionDetails;
 use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
 use Zynga\Framework\Type\V1\UInt64Box;
@@ -24,6 +25,7 @@ abstract class Base<TType as TypeInterface> extends FactoryBaseConfig
   private string $_currentServer;
   private string $_currentDatabase;
   private Vector<ConnectionDetails> $_servers = Vector {};
+  private ?BucketMap $_bucketMap = null;
 
   final public function __construct() {
     $this->_currentServer = '';
@@ -86,9 +88,78 @@ abstract class Base<TType as TypeInterface> extends FactoryBaseConfig
       }
     }
 
+    $this->_bucketMap = null;
+
+    $bucketCount = $this->getVirtualBucketCount();
+
+    if ($bucketCount > 0) {
+
+      $bucketMap = new BucketMap($bucketCount);
+
+      if ($this->bucketsInit($bucketMap) !== true) {
+        throw new ShardsInitFailureException('bucketsInit returned false');
+      }
+
+      $bucketMap->loadMoves($this->getBucketMoves());
+
+      foreach ($bucketMap->toVector() as $bucket => $server) {
+        if ($server >= $this->getServerCount()) {
+          throw new InvalidShardIdException(
+            'bucket='.$bucket.' maps to missing server='.$server,
+          );
+        }
+      }
+
+      foreach ($bucketMap->getMigratingBuckets() as $bucket => $server) {
+        if ($server >= $this->getServerCount()) {
+          throw new InvalidShardIdException(
+            'bucket='.$bucket.' is moving off missing server='.$server,
+          );
+        }
+      }
+
+      $this->_bucketMap = $bucketMap;
+
+    }
+
+    return true;
+  }
+
+  /**
+   * Number of virtual buckets shard values are hashed into, 0 keeps the
+   * plain value % serverCount mapping. Pick a large fixed number up front,
+   * it cannot change without remapping every value.
+   */
+  public function getVirtualBucketCount(): int {
+    return 0;
+  }
+
+  /**
+   * Fills in the bucket -> server table, override to load the persisted
+   * layout. Defaults to spreading buckets round robin over the servers.
+   */
+  public function bucketsInit(BucketMap $bucketMap): bool {
+    $serverCount = $this->getServerCount();
+    for ($bucket = 0; $bucket < $bucketMap->getBucketCount(); $bucket++) {
+      $bucketMap->assign($bucket, $bucket % $serverCount);
+    }
     return true;
   }
 
+  /**
+   * Buckets that are mid-move, bucket => server it is moving off of, with
+   * bucketsInit() already pointing them at the new server. Override to load
+   * them from the same persisted layout so every worker and host shares the
+   * dual read window while rows are copied.
+   */
+  public function getBucketMoves(): Map<int, int> {
+    return Map {};
+  }
+
+  final public function getBucketMap(): ?BucketMap {
+    return $this->_bucketMap;
+  }
+
   final public function getCurrentServer(): string {
     return $this->_currentServer;
   }
@@ -141,6 +212,12 @@ abstract class Base<TType as TypeInterface> extends FactoryBaseConfig
 
   public function getShardId(TType $intShardType): int {
     if ($intShardType instanceof UInt64Box) {
+      $bucketMap = $this->_bucketMap;
+      if ($bucketMap !== null) {
+        return $bucketMap->getServer(
+          $bucketMap->getBucketForValue($intShardType->get()),
+        );
+      }
       $shardCount = $this->getServerCount();
       $shardId = $intShardType->get() % $shardCount;
       return $shardId;
@@ -149,6 +226,20 @@ abstract class Base<TType as TypeInterface> extends FactoryBaseConfig
     throw new UnknownShardTypeException("Unsupported TType");
   }
 
+  /**
+   * Server the shard type's bucket is being moved off of, reads that miss on
+   * getShardId() should be retried here. Null when nothing is moving.
+   */
+  public function getFallbackShardId(TType $intShardType): ?int {
+    $bucketMap = $this->_bucketMap;
+    if ($bucketMap !== null && $intShardType instanceof UInt64Box) {
+      return $bucketMap->getMigrationSource(
+        $bucketMap->getBucketForValue($intShardType->get()),
+      );
+    }
+    return null;
+  }
+
   /**
    * User definable and overloadable hook for initializing your cluster.
    * @return bool
@@ -0,0 +1,269 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Driver;
+
+use Zynga\Framework\Database\V2\Exceptions\ConnectionIsReadOnly;
+use Zynga\Framework\Database\V2\Exceptions\QueryFailedException;
+use Zynga\Framework\Exception\V1\Exception;
+use Zynga\Framework\ShardedDatabase\V3\Driver\AsyncMysql\ResultSet;
+use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO;
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidShardIdException;
+use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverConfigInterface;
+use Zynga\Framework\ShardedDatabase\V3\Interfaces\ResultSetInterface;
+use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
+
+use \AsyncMysqlClient;
+use \AsyncMysqlConnection;
+use \AsyncMysqlException;
+
+/**
+ * Mysql sharded driver that can talk to many shards at once. The blocking
+ * query() / quote() / transaction() paths are the GenericPDO ones, the gen*
+ * apis run over the non-blocking async mysql client so a fan out across every
+ * shard costs the slowest shard instead of the sum of them.
+ */
+class AsyncMysql<TType as TypeInterface> extends GenericPDO<TType> {
+  const int DEFAULT_MAX_CONCURRENCY = 16;
+  const int DEFAULT_TIMEOUT_MICROS = 5000000;
+
+  // Idle connections per shard, a connection is taken out while its query is
+  // in flight so two queries on one shard never share a connection.
+  private Map<int, Vector<AsyncMysqlConnection>> $_asyncConnections;
+  private int $_maxConcurrency;
+  private int $_timeoutMicros;
+
+  public function __construct(DriverConfigInterface<TType> $config) {
+
+    parent::__construct($config);
+
+    $this->_asyncConnections = Map {};
+    $this->_maxConcurrency = self::DEFAULT_MAX_CONCURRENCY;
+    $this->_timeoutMicros = self::DEFAULT_TIMEOUT_MICROS;
+
+  }
+
+  public function getMaxConcurrency(): int {
+    return $this->_maxConcurrency;
+  }
+
+  public function setMaxConcurrency(int $maxConcurrency): bool {
+    if ($maxConcurrency < 1) {
+      throw new Exception('maxConcurrency must be at least 1');
+    }
+    $this->_maxConcurrency = $maxConcurrency;
+    return true;
+  }
+
+  /**
+   * One budget per shard, the connect and the query share it.
+   */
+  public function getShardTimeoutMicros(): int {
+    return $this->_timeoutMicros;
+  }
+
+  public function setShardTimeoutMicros(int $timeoutMicros): bool {
+    $this->_timeoutMicros = $timeoutMicros;
+    return true;
+  }
+
+  public function disconnect(): bool {
+    foreach ($this->_asyncConnections as $idle) {
+      foreach ($idle as $conn) {
+        $conn->close();
+      }
+    }
+    $this->_asyncConnections->clear();
+    return parent::disconnect();
+  }
+
+  /**
+   * Runs the sql against the shard for the current shard type.
+   */
+  public async function genQuery(string $sql): Awaitable<ResultSetInterface> {
+    $shardIndex = $this->getConfig()->getShardId($this->getShardType());
+    return await $this->genQueryShard($shardIndex, $sql);
+  }
+
+  public async function genQueryShard(
+    int $shardIndex,
+    string $sql,
+  ): Awaitable<ResultSetInterface> {
+
+    $config = $this->getConfig();
+
+    if ($config->isDatabaseReadOnly() === true &&
+        $this->isSqlDML($sql) === true) {
+      throw new ConnectionIsReadOnly('sql='.$sql);
+    }
+
+    if ($shardIndex < 0 || $shardIndex >= $config->getShardCount()) {
+      throw new InvalidShardIdException('shardIndex='.$shardIndex);
+    }
+
+    $start = microtime(true);
+    $deadline = $start + ($this->_timeoutMicros / 1000000);
+
+    try {
+
+      $conn = await $this->genConnection($shardIndex, $deadline);
+
+      $remainingMicros = $this->getRemainingMicros($deadline);
+
+      if ($remainingMicros <= 0) {
+        $this->releaseConnection($shardIndex, $conn);
+        throw new QueryFailedException(
+          'shardIndex='.$shardIndex.' error=timed out connecting',
+        );
+      }
+
+      // The connection is only handed back once the query is done with it, a
+      // failed query leaves it out of the pool as it may still be mid-query
+      // on the server.
+      $result = await $conn->query($sql, $remainingMicros);
+
+      $this->releaseConnection($shardIndex, $conn);
+
+      $this->setShardLatency($shardIndex, (microtime(true) - $start) * 1000);
+
+      return new ResultSet($sql, $result);
+
+    } catch (AsyncMysqlException $e) {
+      $this->setShardLatency($shardIndex, (microtime(true) - $start) * 1000);
+      throw new QueryFailedException(
+        'shardIndex='.$shardIndex.' error='.$e->getMessage(),
+      );
+    }
+
+  }
+
+  /**
+   * Runs the same sql against every shard (or the given subset), at most
+   * getMaxConcurrency() shards are in flight at a time. Each slot picks up the
+   * next shard as soon as its current one finishes, so a slow shard only
+   * holds up its own slot.
+   */
+  public async function genQueryAllShards(
+    string $sql,
+    ?Vector<int> $shardIndexes = null,
+  ): Awaitable<Map<int, ResultSetInterface>> {
+
+    if ($shardIndexes === null) {
+      $shardIndexes = $this->getAllShardIndexes();
+    }
+
+    $this->getShardLatencies()->clear();
+
+    // Popped from the end, reversed so the shards start in the order given.
+    $queue = $shardIndexes->toVector();
+    $queue->reverse();
+
+    $results = Map {};
+
+    $slots = Vector {};
+    $slotCount = min($this->_maxConcurrency, $queue->count());
+
+    for ($slot = 0; $slot < $slotCount; $slot++) {
+      $slots->add($this->genQueueWorker($sql, $queue, $results));
+    }
+
+    await \HH\Asio\v($slots);
+
+    // Hand the results back in the order the shards were asked for.
+    $ordered = Map {};
+    foreach ($shardIndexes as $shardIndex) {
+      $resultSet = $results->get($shardIndex);
+      if ($resultSet !== null) {
+        $ordered->set($shardIndex, $resultSet);
+      }
+    }
+
+    return $ordered;
+
+  }
+
+  public function queryAllShards(
+    string $sql,
+    ?Vector<int> $shardIndexes = null,
+  ): Map<int, ResultSetInterface> {
+    try {
+      return \HH\Asio\join($this->genQueryAllShards($sql, $shardIndexes));
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
+
+  /**
+   * One concurrency slot, keeps pulling shards off the shared queue until it
+   * is empty. Awaitables interleave on one thread so the queue needs no lock.
+   */
+  private async function genQueueWorker(
+    string $sql,
+    Vector<int> $queue,
+    Map<int, ResultSetInterface> $results,
+  ): Awaitable<void> {
+
+    while ($queue->count() > 0) {
+      $shardIndex = $queue->pop();
+      $resultSet = await $this->genQueryShard($shardIndex, $sql);
+      $results->set($shardIndex, $resultSet);
+    }
+
+  }
+
+  private async function genConnection(
+    int $shardIndex,
+    float $deadline,
+  ): Awaitable<AsyncMysqlConnection> {
+
+    $idle = $this->_asyncConnections->get($shardIndex);
+
+    while ($idle !== null && $idle->count() > 0) {
+      $conn = $idle->pop();
+      if ($conn->isValid() === true) {
+        return $conn;
+      }
+    }
+
+    $remainingMicros = $this->getRemainingMicros($deadline);
+
+    if ($remainingMicros <= 0) {
+      throw new QueryFailedException(
+        'shardIndex='.$shardIndex.' error=timed out connecting',
+      );
+    }
+
+    $config = $this->getConfig();
+    $server = $config->getServerByOffset($shardIndex);
+
+    return await AsyncMysqlClient::connect(
+      $server->getHostname(),
+      $server->getPort(),
+      $config->getDatabaseName(),
+      $server->getUsername(),
+      $server->getPassword(),
+      $remainingMicros,
+    );
+
+  }
+
+  private function releaseConnection(
+    int $shardIndex,
+    AsyncMysqlConnection $conn,
+  ): void {
+
+    $idle = $this->_asyncConnections->get($shardIndex);
+
+    if ($idle === null) {
+      $idle = Vector {};
+      $this->_asyncConnections->set($shardIndex, $idle);
+    }
+
+    $idle->add($conn);
+
+  }
+
+  private function getRemainingMicros(float $deadline): int {
+    return intval(($deadline - microtime(true)) * 1000000);
+  }
+
+}
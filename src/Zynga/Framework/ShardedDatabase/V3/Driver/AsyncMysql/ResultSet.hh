@@ -0,0 +1,246 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Driver\AsyncMysql;
+
+use Zynga\Framework\Database\V2\Exceptions\NoActiveCursorException;
+use Zynga\Framework\Database\V2\Exceptions\OutOfBoundsForCursorException;
+use Zynga\Framework\ShardedDatabase\V3\Driver\ResultSet\Base;
+
+use \AsyncMysqlQueryResult;
+
+/**
+ * Fully buffered rows from a async mysql query. The async client hands the
+ * whole result back at once so there is no live cursor to keep open. Rows are
+ * only copied out of the client result on first access, and only as maps,
+ * fetchVector() reads the values back out of the map row.
+ */
+class ResultSet extends Base {
+  private string $_sql;
+  private ?AsyncMysqlQueryResult $_result;
+  private ?Vector<Map<string, mixed>> $_rows;
+  private int $_numRows;
+  private int $_affectedRows;
+  private int $_currentPosition;
+  private bool $_hasCursor;
+
+  public function __construct(string $sql, AsyncMysqlQueryResult $result) {
+
+    parent::__construct();
+
+    $this->_sql = $sql;
+    $this->_result = $result;
+    $this->_rows = null;
+    $this->_numRows = $result->numRows();
+    $this->_affectedRows = $result->numRowsAffected();
+    $this->_currentPosition = -1;
+    $this->_hasCursor = true;
+
+  }
+
+  private function getRows(): Vector<Map<string, mixed>> {
+
+    $rows = $this->_rows;
+
+    if ($rows !== null) {
+      return $rows;
+    }
+
+    $rows = Vector {};
+
+    $result = $this->_result;
+
+    if ($result !== null) {
+      foreach ($result->mapRows() as $rawRow) {
+        $row = Map {};
+        foreach ($rawRow as $key => $value) {
+          $row->set($key, $value);
+        }
+        $rows->add($row);
+      }
+    }
+
+    // The client result is no longer needed once the rows are copied out.
+    $this->_result = null;
+    $this->_rows = $rows;
+
+    return $rows;
+
+  }
+
+  public function wasSuccessful(): bool {
+    return true;
+  }
+
+  public function hasCursor(): bool {
+    return $this->_hasCursor;
+  }
+
+  public function freeCursor(): bool {
+    if ($this->_hasCursor === true) {
+      $this->_hasCursor = false;
+      $this->_result = null;
+      $this->_rows = Vector {};
+      $this->_numRows = 0;
+      $this->_currentPosition = -1;
+      return true;
+    }
+    return false;
+  }
+
+  public function getNumRows(): int {
+    if ($this->wasSqlDML() === true) {
+      return $this->_affectedRows;
+    }
+    return $this->_numRows;
+  }
+
+  public function rewind(int $pos): bool {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'rewind requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    if ($pos > $this->_numRows || $pos < 0) {
+      throw new OutOfBoundsForCursorException('OOB pos='.$pos);
+    }
+
+    $this->_currentPosition = $pos - 1;
+
+    return true;
+
+  }
+
+  public function hasMore(): bool {
+    if (($this->_currentPosition + 1) < $this->_numRows) {
+      return true;
+    }
+    return false;
+  }
+
+  public function next(): bool {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'next() requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    if ($this->hasMore() === true) {
+      $this->_currentPosition++;
+      return true;
+    }
+
+    return false;
+
+  }
+
+  public function fetchMap(): Map<string, mixed> {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'fetchMap requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    $row = $this->getRows()->get($this->_currentPosition);
+
+    if ($row === null) {
+      return Map {};
+    }
+
+    return $row;
+
+  }
+
+  public function fetchVector(): Vector<int> {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'fetchVector requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    $data = Vector {};
+
+    $row = $this->getRows()->get($this->_currentPosition);
+
+    if ($row !== null) {
+      foreach ($row as $value) {
+        $data->add($value);
+      }
+    }
+
+    return $data;
+
+  }
+
+  public function fetchAllColumns(): Map<string, Vector<mixed>> {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'fetchAllColumns requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    $columns = Map {};
+
+    $rows = $this->getRows();
+
+    for ($offset = $this->_currentPosition + 1;
+         $offset < $rows->count();
+         $offset++) {
+      foreach ($rows[$offset] as $name => $value) {
+        $column = $columns->get($name);
+        if ($column === null) {
+          $column = Vector {};
+          $columns->set($name, $column);
+        }
+        $column->add($value);
+      }
+    }
+
+    $this->_currentPosition = $rows->count() - 1;
+
+    return $columns;
+
+  }
+
+  public function fetchAllVectors(): Vector<Vector<mixed>> {
+
+    if ($this->_hasCursor !== true) {
+      throw new NoActiveCursorException(
+        'fetchAllVectors requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    $rows = Vector {};
+
+    foreach ($this->getRows()->skip($this->_currentPosition + 1) as $row) {
+      $rows->add($row->values());
+    }
+
+    $this->_currentPosition = $this->_numRows - 1;
+
+    return $rows;
+
+  }
+
+  public function setSql(string $sql): bool {
+    $this->_sql = $sql;
+    return true;
+  }
+
+  public function getSql(): string {
+    return $this->_sql;
+  }
+
+  public function wasSqlDML(): bool {
+    if (preg_match('/\s*(INSERT|UPDATE|DELETE)/i', $this->_sql)) {
+      return true;
+    }
+    return false;
+  }
+
+}
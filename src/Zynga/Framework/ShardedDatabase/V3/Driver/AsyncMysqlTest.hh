@@ -0,0 +1,145 @@
+<?hh //strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Driver;
+
+use Zynga\Framework\Exception\V1\Exception;
+use Zynga\Framework\ShardedDatabase\V3\Driver\AsyncMysql;
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidShardIdException;
+use Zynga\Framework\ShardedDatabase\V3\Factory as DatabaseFactory;
+use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverInterface;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+use Zynga\Framework\Type\V1\UInt64Box;
+
+class AsyncMysqlTest extends TestCase {
+
+  public function doSetUpBeforeClass(): bool {
+
+    parent::doSetUpBeforeClass();
+
+    DatabaseFactory::disableMockDrivers();
+    DatabaseFactory::clear();
+
+    return true;
+
+  }
+
+  public function doTearDownAfterClass(): bool {
+
+    DatabaseFactory::enableMockDrivers();
+    DatabaseFactory::clear();
+
+    return true;
+
+  }
+
+  private function getAsyncDriver(): AsyncMysql<UInt64Box> {
+    $dbh =
+      DatabaseFactory::getDriver('Test\AsyncMysql', new UInt64Box(1));
+    if ($dbh instanceof AsyncMysql) {
+      return $dbh;
+    }
+    throw new Exception('Test\AsyncMysql should use the AsyncMysql driver');
+  }
+
+  public function testQueryAllShards(): void {
+
+    $dbh = $this->getAsyncDriver();
+
+    $results = $dbh->queryAllShards('SELECT 1 AS one');
+
+    $this->assertEquals($dbh->getConfig()->getShardCount(), $results->count());
+
+    foreach ($results as $shardIndex => $resultSet) {
+      $this->assertTrue($resultSet->wasSuccessful());
+      $this->assertEquals(1, $resultSet->getNumRows());
+      $this->assertTrue($resultSet->next());
+      $this->assertEquals(Map {'one' => 1}, $resultSet->fetchMap());
+      $this->assertFalse($resultSet->hasMore());
+    }
+
+  }
+
+  public function testGenQuery(): void {
+
+    $dbh = $this->getAsyncDriver();
+
+    $resultSet = \HH\Asio\join($dbh->genQuery('SELECT 2 AS two'));
+
+    $this->assertTrue($resultSet->next());
+    $this->assertEquals(Vector {2}, $resultSet->fetchVector());
+
+  }
+
+  public function testQueryAllShards_SlidingWindow(): void {
+
+    $dbh = $this->getAsyncDriver();
+    $dbh->setMaxConcurrency(1);
+
+    // Asked for in reverse so the ordering of the results is observable.
+    $shardIndexes = Vector {};
+    for ($shardIndex = $dbh->getConfig()->getShardCount() - 1;
+         $shardIndex >= 0;
+         $shardIndex--) {
+      $shardIndexes->add($shardIndex);
+    }
+
+    $results = $dbh->queryAllShards('SELECT 1 AS one', $shardIndexes);
+
+    // Results come back in the order the shards were asked for.
+    $this->assertEquals($shardIndexes, $results->keys());
+    $this->assertEquals(
+      $shardIndexes->count(),
+      $dbh->getShardLatencies()->count(),
+    );
+
+    $dbh->setMaxConcurrency(AsyncMysql::DEFAULT_MAX_CONCURRENCY);
+
+  }
+
+  public function testGenQueryShard_SameShardConcurrently(): void {
+
+    $dbh = $this->getAsyncDriver();
+
+    // Each in flight query gets its own connection to the shard.
+    $results = \HH\Asio\join(
+      \HH\Asio\v(
+        Vector {
+          $dbh->genQueryShard(0, 'SELECT 1 AS one'),
+          $dbh->genQueryShard(0, 'SELECT 2 AS two'),
+        },
+      ),
+    );
+
+    $this->assertTrue($results[0]->next());
+    $this->assertEquals(Map {'one' => 1}, $results[0]->fetchMap());
+    $this->assertTrue($results[1]->next());
+    $this->assertEquals(Vector {2}, $results[1]->fetchVector());
+
+  }
+
+  public function testGenQueryShard_InvalidShard(): void {
+    $dbh = $this->getAsyncDriver();
+    $this->expectException(InvalidShardIdException::class);
+    \HH\Asio\join($dbh->genQueryShard(-1, 'SELECT 1'));
+  }
+
+  public function testSettings(): void {
+
+    $dbh = $this->getAsyncDriver();
+
+    $this->assertEquals(
+      AsyncMysql::DEFAULT_MAX_CONCURRENCY,
+      $dbh->getMaxConcurrency(),
+    );
+    $this->assertTrue($dbh->setMaxConcurrency(1));
+    $this->assertEquals(1, $dbh->getMaxConcurrency());
+
+    $this->assertTrue($dbh->setShardTimeoutMicros(1000000));
+    $this->assertEquals(1000000, $dbh->getShardTimeoutMicros());
+
+    $this->expectException(Exception::class);
+    $dbh->setMaxConcurrency(0);
+
+  }
+
+}
@@ -4,6 +4,9 @@ namespace Zynga\Framework\ShardedDatabase\V3\Driver;
 
 use Zynga\Framework\Database\V2\Exceptions\MissingUserIdException;
 use Zynga\Framework\Database\V2\Interfaces\QuoteInterface;
+use
+  Zynga\Framework\Database\V2\Interfaces\ResultSetInterface as BaseResultSetInterface
+;
 use
   Zynga\Framework\Environment\ErrorCapture\V1\Handler\Noop as ErrorCaptureNoop
 ;
@@ -13,7 +16,9 @@ use
 use Zynga\Framework\ShardedDatabase\V3\Exceptions\UnknownShardTypeException;
 use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverConfigInterface;
 use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverInterface;
+use Zynga\Framework\ShardedDatabase\V3\Interfaces\ResultSetInterface;
 use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
+use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
 
 abstract class Base<TType as TypeInterface>
@@ -21,10 +26,12 @@ abstract class Base<TType as TypeInterface>
   private DriverConfigInterface<TType> $_config;
   private ErrorCaptureInterface $_errorCapture;
   private ?TType $_shardType;
+  private Map<int, float> $_shardLatencies;
 
   public function __construct(DriverConfigInterface<TType> $config) {
     $this->_config = $config;
     $this->_errorCapture = new ErrorCaptureNoop();
+    $this->_shardLatencies = Map {};
   }
 
   public function getConfig(): DriverConfigInterface<TType> {
@@ -71,4 +78,86 @@ abstract class Base<TType as TypeInterface>
     }
     return false;
   }
+
+  public function getShardLatencies(): Map<int, float> {
+    return $this->_shardLatencies;
+  }
+
+  protected function setShardLatency(int $shardIndex, float $latency): void {
+    $this->_shardLatencies->set($shardIndex, $latency);
+  }
+
+  protected function getAllShardIndexes(): Vector<int> {
+    $shardIndexes = Vector {};
+    for ($shardIndex = 0;
+         $shardIndex < $this->getConfig()->getShardCount();
+         $shardIndex++) {
+      $shardIndexes->add($shardIndex);
+    }
+    return $shardIndexes;
+  }
+
+  /**
+   * Fallback for drivers without a non-blocking path, one shard after the
+   * other through queryShard(). Nothing here runs concurrently, callers such
+   * as PgData's ScatterGather only fan out in parallel on AsyncMysql.
+   */
+  public async function genQueryAllShards(
+    string $sql,
+    ?Vector<int> $shardIndexes = null,
+  ): Awaitable<Map<int, ResultSetInterface>> {
+
+    if ($shardIndexes === null) {
+      $shardIndexes = $this->getAllShardIndexes();
+    }
+
+    $this->_shardLatencies->clear();
+
+    $results = Map {};
+
+    foreach ($shardIndexes as $shardIndex) {
+      $start = microtime(true);
+      $results->set($shardIndex, $this->queryShard($shardIndex, $sql));
+      $this->setShardLatency($shardIndex, (microtime(true) - $start) * 1000);
+    }
+
+    return $results;
+
+  }
+
+  /**
+   * Fallback for drivers without a multi statement path, one round trip per
+   * statement against the current shard.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<BaseResultSetInterface> {
+
+    $results = Vector {};
+
+    if ($atomic === true) {
+      $this->transaction()->begin();
+    }
+
+    try {
+
+      foreach ($statements as $sql) {
+        $results->add($this->query($sql));
+      }
+
+      if ($atomic === true) {
+        $this->transaction()->commit();
+      }
+
+      return $results;
+
+    } catch (Exception $e) {
+      if ($atomic === true) {
+        $this->transaction()->rollback();
+      }
+      throw $e;
+    }
+
+  }
 }
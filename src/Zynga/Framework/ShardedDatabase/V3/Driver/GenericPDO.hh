@@ -15,7 +15,12 @@ use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\Quoter;
 use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\Transaction;
 use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\ResultSet;
 use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\ConnectionContainer;
+use Zynga\Framework\ShardedDatabase\V3\Exceptions\InvalidShardIdException;
 use Zynga\Framework\ShardedDatabase\V3\Interfaces\ResultSetInterface;
+use Zynga\Framework\Database\V2\Driver\GenericPDO\Batch;
+use
+  Zynga\Framework\Database\V2\Interfaces\ResultSetInterface as BaseResultSetInterface
+;
 use Zynga\Framework\ShardedDatabase\V3\Interfaces\DriverConfigInterface;
 use Zynga\Framework\Database\V2\Interfaces\QuoteInterface;
 use Zynga\Framework\Database\V2\Interfaces\TransactionInterface;
@@ -28,12 +33,14 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
 
   private ConnectionContainer $_connections;
   private ?QuoteInterface $_quoter;
-  private ?TransactionInterface $_transaction;
+  private ?Transaction<TType> $_transaction;
 
   private Map<int, bool> $_connectionState;
   private bool $_hadError;
   private string $_lastError;
   private int $connectedShardId;
+  private int $_maxBufferedBytes;
+  private bool $_isUnbufferedStreaming;
 
   public static bool $FORCE_COVERAGE = false;
 
@@ -50,6 +57,38 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
     $this->_quoter = null;
     $this->_transaction = null;
     $this->connectedShardId = -1;
+    $this->_maxBufferedBytes = ResultSet::DEFAULT_MAX_BUFFERED_BYTES;
+    $this->_isUnbufferedStreaming = false;
+  }
+
+  /**
+   * Byte cap for buffering result sets in memory, past it rows are streamed.
+   * ResultSet::BUFFERING_DISABLED keeps the scrollable cursor.
+   */
+  public function getMaxBufferedBytes(): int {
+    return $this->_maxBufferedBytes;
+  }
+
+  public function setMaxBufferedBytes(int $maxBufferedBytes): bool {
+    $this->_maxBufferedBytes = $maxBufferedBytes;
+    return true;
+  }
+
+  /**
+   * Opt in to reading rows straight off the wire instead of letting
+   * libmysql buffer the whole result first. Saves the second copy of a large
+   * result, but while a result is streaming the shard's connection can not
+   * run anything else (MySQL error 2014), that includes the pool's health
+   * check, the dual read fallback and any nested read. Only turn it on for
+   * a read that is drained before the next query.
+   */
+  public function getIsUnbufferedStreaming(): bool {
+    return $this->_isUnbufferedStreaming;
+  }
+
+  public function setIsUnbufferedStreaming(bool $isUnbufferedStreaming): bool {
+    $this->_isUnbufferedStreaming = $isUnbufferedStreaming;
+    return true;
   }
 
   public function getQuoter(): QuoteInterface {
@@ -61,11 +100,13 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
   }
 
   public function getTransaction(): TransactionInterface {
-    if ($this->_transaction === null) {
-      $this->_transaction = new Transaction($this);
+    $transaction = $this->_transaction;
+    if ($transaction === null) {
+      $transaction = new Transaction($this);
+      $this->_transaction = $transaction;
     }
 
-    return $this->_transaction;
+    return $transaction;
   }
 
   public function setIsConnected(bool $value): bool {
@@ -77,22 +118,28 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
   public function getIsConnected(): bool {
     $shardId = $this->getConfig()->getShardId($this->getShardType());
     if ($this->_connectionState->containsKey($shardId) === true &&
-        $this->_connectionState[$shardId] === true) {
+        $this->_connectionState[$shardId] === true &&
+        $this->_connections->isDriverCached($shardId) === true) {
       return true;
     }
 
     return false;
   }
 
+  public function getConnectionPool(): ConnectionContainer {
+    return $this->_connections;
+  }
+
+  public function getConnectionReuseRate(): float {
+    return $this->_connections->getReuseRate();
+  }
+
   public function connectToShard(
     int $shardIndex,
     string $connectionString,
   ): bool {
     try {
-      if ($this->getIsConnected() === true) {
-        return true;
-      }
-
+      // Shards we have already been on are handed back by the pool.
       $server = $this->getConfig()->getServerByOffset($shardIndex);
       $username = $server->getUsername();
       $password = $server->getPassword();
@@ -153,27 +200,55 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
         throw new ConnectionIsReadOnly('sql='.$sql);
       }
 
-      if ($this->getIsConnected() == true) {
-        $shardType = $this->getShardType();
-        if ($this->connectedShardId !=
-            $this->getConfig()->getShardId($shardType)) {
-          $this->disconnect();
-        }
+      // Moving to another shard leaves the previous connection in the pool,
+      // staying on one still goes through the pool's checked get so a dead
+      // idle connection is caught and reuse is counted.
+      $shardId = $this->getConfig()->getShardId($this->getShardType());
+
+      if ($this->connect() !== true) {
+        throw new QueryFailedException('Failed to connect');
       }
 
-      if ($this->getIsConnected() !== true) {
-        if ($this->connect() !== true) {
-          throw new QueryFailedException('Failed to connect');
+      $resultSet = $this->executeOnShard($shardId, $sql);
+
+      // Dual read, only a select keyed to a bucket that is mid-move can miss
+      // because its row has not been copied over yet. Everything else is
+      // answered by the shard it was sent to.
+      if ($resultSet->getNumRows() == 0 && $this->isSqlSelect($sql) === true) {
+        $fallbackShardId =
+          $this->getConfig()->getFallbackShardId($this->getShardType());
+        if ($fallbackShardId !== null && $fallbackShardId != $shardId) {
+          return $this->queryFallbackShard($fallbackShardId, $sql);
         }
       }
 
-      $dbh = $this->_connections->get($this->connectedShardId);
-      $options = array();
-      $options[PDO::ATTR_CURSOR] = PDO::CURSOR_SCROLL;
-      $sth = $dbh->prepare($sql, $options);
-      $sth->execute();
+      return $resultSet;
+    } catch (PDOException $e) {
+      $this->_hadError = true;
+      $this->_lastError = $e->getMessage();
+
+      throw new QueryFailedException($e->getMessage());
+    } catch (Exception $e) {
+      throw $e;
+    }
+  }
 
-      return new ResultSet($sql, $sth);
+  public function queryShard(int $shardIndex, string $sql): ResultSetInterface {
+    try {
+      $config = $this->getConfig();
+
+      if ($config->isDatabaseReadOnly() === true &&
+          $this->isSqlDML($sql) === true) {
+        throw new ConnectionIsReadOnly('sql='.$sql);
+      }
+
+      if ($shardIndex < 0 || $shardIndex >= $config->getShardCount()) {
+        throw new InvalidShardIdException('shardIndex='.$shardIndex);
+      }
+
+      $this->connectToShardIndex($shardIndex);
+
+      return $this->executeOnShard($shardIndex, $sql);
     } catch (PDOException $e) {
       $this->_hadError = true;
       $this->_lastError = $e->getMessage();
@@ -184,6 +259,119 @@ class GenericPDO<TType as TypeInterface> extends Base<TType> {
     }
   }
 
+  /**
+   * Multi statement batch against the current shard, one round trip. When
+   * atomic the batch is bracketed with START TRANSACTION / COMMIT and a
+   * failure part way issues a ROLLBACK on the same connection. Inside an
+   * already open transaction the bracket is left off, a START TRANSACTION
+   * there would implicitly commit the caller's work.
+   */
+  public function queryBatch(
+    Vector<string> $statements,
+    bool $atomic = false,
+  ): Vector<BaseResultSetInterface> {
+
+    if ($statements->count() == 0) {
+      return Vector {};
+    }
+
+    try {
+
+      foreach ($statements as $statement) {
+        if ($this->getConfig()->isDatabaseReadOnly() === true &&
+            $this->isSqlDML(trim($statement)) === true) {
+          throw new ConnectionIsReadOnly('sql='.$statement);
+        }
+      }
+
+      $shardId = $this->getConfig()->getShardId($this->getShardType());
+
+      if ($this->connect() !== true) {
+        throw new QueryFailedException('Failed to connect');
+      }
+
+      $dbh = $this->_connections->get($shardId);
+
+      $batch = new Batch(
+        $statements,
+        $atomic === true && $this->isInTransaction($dbh) !== true,
+      );
+
+      return $batch->execute($dbh);
+
+    } catch (QueryFailedException $e) {
+      $this->_hadError = true;
+      $this->_lastError = $e->getMessage();
+      throw $e;
+    } catch (Exception $e) {
+      throw $e;
+    }
+
+  }
+
+  private function isInTransaction(PDO $dbh): bool {
+    $transaction = $this->_transaction;
+    if ($transaction !== null && $transaction->isOpen() === true) {
+      return true;
+    }
+    return $dbh->inTransaction();
+  }
+
+  private function executeOnShard(int $shardId, string $sql): ResultSet {
+    $dbh = $this->_connections->get($shardId);
+    $options = array();
+    if ($this->_maxBufferedBytes == ResultSet::BUFFERING_DISABLED) {
+      // Random access fetches need libmysql's copy of the whole result.
+      $options[PDO::ATTR_CURSOR] = PDO::CURSOR_SCROLL;
+      $options[PDO::MYSQL_ATTR_USE_BUFFERED_QUERY] = true;
+    } else {
+      // The result set buffers under its own byte cap. libmysql keeps its
+      // copy too unless streaming was asked for, so the connection is free
+      // for other queries while this result is still open.
+      $options[PDO::ATTR_CURSOR] = PDO::CURSOR_FWDONLY;
+      $options[PDO::MYSQL_ATTR_USE_BUFFERED_QUERY] =
+        $this->_isUnbufferedStreaming !== true;
+    }
+    $sth = $dbh->prepare($sql, $options);
+    $sth->execute();
+
+    return new ResultSet($sql, $sth, $this->_maxBufferedBytes);
+  }
+
+  private function isSqlSelect(string $sql): bool {
+    if (preg_match('/^\s*SELECT/i', $sql)) {
+      return true;
+    }
+    return false;
+  }
+
+  private function queryFallbackShard(
+    int $fallbackShardId,
+    string $sql,
+  ): ResultSet {
+    $this->connectToShardIndex($fallbackShardId);
+    return $this->executeOnShard($fallbackShardId, $sql);
+  }
+
+  /**
+   * Makes sure the pool holds a connection to the shard without moving the
+   * driver off its current shard.
+   */
+  private function connectToShardIndex(int $shardIndex): void {
+    $config = $this->getConfig();
+    $server = $config->getServerByOffset($shardIndex);
+
+    $connectionString =
+      $config->getConnectionStringForServer($this->getShardType(), $server);
+
+    $this->_connections->create(
+      $shardIndex,
+      $connectionString,
+      $server->getUsername(),
+      $server->getPassword(),
+    );
+  }
+
   public function nativeQuoteString(string $value): string {
     try {
       $shardType = $this->getShardType();
@@ -10,12 +10,30 @@ use \PDOException;
 
 use Zynga\Framework\Exception\V1\Exception;
 
+/**
+ * Pool of live connections keyed by shard index. Connections stay open when
+ * the driver moves between shards so switching back is free, bounded by an
+ * LRU cap and an idle timeout. A connection that has sat idle longer than the
+ * health check interval is pinged before it is handed back out.
+ */
 class ConnectionContainer {
+  const int DEFAULT_MAX_CONNECTIONS = 8;
+  const int DEFAULT_MAX_IDLE_SECONDS = 300;
+  const int DEFAULT_HEALTH_CHECK_SECONDS = 30;
 
+  // Ordered by last use, the first key is the least recently used.
   private Map<int, PDO> $_connections = Map {};
+  private Map<int, int> $_lastUsed = Map {};
+
+  private int $_maxConnections = self::DEFAULT_MAX_CONNECTIONS;
+  private int $_maxIdleSeconds = self::DEFAULT_MAX_IDLE_SECONDS;
+  private int $_healthCheckSeconds = self::DEFAULT_HEALTH_CHECK_SECONDS;
+
+  private int $_reused = 0;
+  private int $_created = 0;
 
   public function isDriverCached(int $shardId): bool {
-    if (array_key_exists($shardId, $this->_connections)) {
+    if ($this->_connections->containsKey($shardId)) {
       return true;
     }
     return false;
@@ -27,21 +45,50 @@ class ConnectionContainer {
     string $username,
     string $password,
   ): bool {
+    $this->checkout($shardId, $dsn, $username, $password);
+    return true;
+  }
+
+  /**
+   * Checked get, reaps idle connections and pings a stale one before handing
+   * it back, opening a fresh connection when there is nothing usable pooled.
+   */
+  public function checkout(
+    int $shardId,
+    string $dsn,
+    string $username,
+    string $password,
+  ): PDO {
     try {
 
-      if ($this->isDriverCached($shardId) === true) {
-        return true;
+      $now = time();
+
+      $this->reapIdle($now);
+
+      if ($this->isDriverCached($shardId) === true &&
+          $this->isHealthy($shardId, $now) === true) {
+        $this->_reused++;
+        $this->touch($shardId, $now);
+        return $this->_connections[$shardId];
       }
 
       $dbh = new PDO($dsn, $username, $password);
-      
+
       // we want our pdo connections to raise exceptions.
       $dbh->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+      // Buffered, so an open result never blocks the next query on this
+      // connection. The driver only turns it off per statement when unbuffered
+      // streaming was asked for.
       $dbh->setAttribute(PDO::MYSQL_ATTR_USE_BUFFERED_QUERY, true);
 
+      $this->_created++;
+
       $this->_connections->set($shardId, $dbh);
+      $this->touch($shardId, $now);
 
-      return true;
+      $this->evict();
+
+      return $dbh;
 
     } catch (PDOException $e) {
       throw new ConnectionGoneAwayException($e->getMessage());
@@ -51,14 +98,138 @@ class ConnectionContainer {
 
   public function get(int $shardId): PDO {
     if ($this->isDriverCached($shardId) === true) {
-      return $this->_connections[$shardId];
+      $dbh = $this->_connections[$shardId];
+      $this->touch($shardId, time());
+      return $dbh;
     }
     throw new InvalidShardException('shardId='.$shardId);
   }
 
+  public function remove(int $shardId): bool {
+    $this->_connections->remove($shardId);
+    $this->_lastUsed->remove($shardId);
+    return true;
+  }
+
   public function clear(): bool {
     $this->_connections->clear();
+    $this->_lastUsed->clear();
     return true;
   }
 
+  public function count(): int {
+    return $this->_connections->count();
+  }
+
+  public function getMaxConnections(): int {
+    return $this->_maxConnections;
+  }
+
+  public function setMaxConnections(int $maxConnections): bool {
+    if ($maxConnections < 1) {
+      throw new Exception('maxConnections must be at least 1');
+    }
+    $this->_maxConnections = $maxConnections;
+    $this->evict();
+    return true;
+  }
+
+  public function getMaxIdleSeconds(): int {
+    return $this->_maxIdleSeconds;
+  }
+
+  public function setMaxIdleSeconds(int $maxIdleSeconds): bool {
+    $this->_maxIdleSeconds = $maxIdleSeconds;
+    return true;
+  }
+
+  public function getHealthCheckSeconds(): int {
+    return $this->_healthCheckSeconds;
+  }
+
+  public function setHealthCheckSeconds(int $healthCheckSeconds): bool {
+    $this->_healthCheckSeconds = $healthCheckSeconds;
+    return true;
+  }
+
+  public function getReusedCount(): int {
+    return $this->_reused;
+  }
+
+  public function getCreatedCount(): int {
+    return $this->_created;
+  }
+
+  /**
+   * Fraction of connection requests served from the pool, 0.0 when nothing
+   * has been requested yet.
+   */
+  public function getReuseRate(): float {
+    $total = $this->_reused + $this->_created;
+    if ($total == 0) {
+      return 0.0;
+    }
+    return $this->_reused / $total;
+  }
+
+  private function touch(int $shardId, int $now): void {
+    // Re-inserting moves the shard to the most recently used end.
+    $dbh = $this->_connections->get($shardId);
+    if ($dbh === null) {
+      return;
+    }
+    $this->_connections->remove($shardId);
+    $this->_connections->set($shardId, $dbh);
+    $this->_lastUsed->set($shardId, $now);
+  }
+
+  private function evict(): void {
+    while ($this->_connections->count() > $this->_maxConnections) {
+      $shardId = $this->_connections->firstKey();
+      if ($shardId === null) {
+        return;
+      }
+      $this->remove($shardId);
+    }
+  }
+
+  private function reapIdle(int $now): void {
+
+    if ($this->_maxIdleSeconds <= 0) {
+      return;
+    }
+
+    $expired = Vector {};
+
+    foreach ($this->_lastUsed as $shardId => $lastUsed) {
+      if ($now - $lastUsed > $this->_maxIdleSeconds) {
+        $expired->add($shardId);
+      }
+    }
+
+    foreach ($expired as $shardId) {
+      $this->remove($shardId);
+    }
+
+  }
+
+  private function isHealthy(int $shardId, int $now): bool {
+
+    $lastUsed = $this->_lastUsed->get($shardId);
+
+    // Recently used connections are trusted, skip the round trip.
+    if ($lastUsed !== null && $now - $lastUsed < $this->_healthCheckSeconds) {
+      return true;
+    }
+
+    try {
+      $this->_connections[$shardId]->query('SELECT 1');
+      return true;
+    } catch (PDOException $e) {
+      $this->remove($shardId);
+      return false;
+    }
+
+  }
+
 }
@@ -3,6 +3,7 @@
 namespace Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO;
 
 use Zynga\Framework\Database\V2\Exceptions\InvalidShardException;
+use Zynga\Framework\Exception\V1\Exception;
 use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
 
 use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\ConnectionContainer;
@@ -66,6 +67,123 @@ class ConnectionContainerTest extends TestCase {
     $this->assertTrue($con->create($shardId, $dsn, $username, $password));
   }
 
+  public function testPoolReuseAndLruCap(): void {
+    $dbh = DatabaseFactory::factory(DriverInterface::class, 'Test\Mysql');
+
+    $testShard = new UInt64Box(1);
+    $config = $dbh->getConfig();
+
+    $dsn = $config->getConnectionString($testShard);
+    $server = $config->getServerFromShardType($testShard);
+    $username = $server->getUsername();
+    $password = $server->getPassword();
+
+    $con = new ConnectionContainer();
+
+    $this->assertEquals(0.0, $con->getReuseRate());
+
+    // Two shard slots pointed at the same server, alternating between them
+    // should only ever connect twice.
+    $this->assertTrue($con->create(0, $dsn, $username, $password));
+    $this->assertTrue($con->create(1, $dsn, $username, $password));
+    $this->assertTrue($con->create(0, $dsn, $username, $password));
+    $this->assertTrue($con->create(1, $dsn, $username, $password));
+
+    $this->assertEquals(2, $con->count());
+    $this->assertEquals(2, $con->getCreatedCount());
+    $this->assertEquals(2, $con->getReusedCount());
+    $this->assertEquals(0.5, $con->getReuseRate());
+
+    // Shard 0 is the least recently used so it goes first.
+    $this->assertTrue($con->setMaxConnections(1));
+    $this->assertEquals(1, $con->count());
+    $this->assertFalse($con->isDriverCached(0));
+    $this->assertTrue($con->isDriverCached(1));
+  }
+
+  public function testCheckoutReturnsPooledConnection(): void {
+    $dbh = DatabaseFactory::factory(DriverInterface::class, 'Test\Mysql');
+
+    $testShard = new UInt64Box(1);
+    $config = $dbh->getConfig();
+
+    $dsn = $config->getConnectionString($testShard);
+    $server = $config->getServerFromShardType($testShard);
+
+    $username = $server->getUsername();
+    $password = $server->getPassword();
+
+    $con = new ConnectionContainer();
+
+    $first = $con->checkout(0, $dsn, $username, $password);
+    $second = $con->checkout(0, $dsn, $username, $password);
+
+    $this->assertSame($first, $second);
+    $this->assertSame($first, $con->get(0));
+    $this->assertEquals(1, $con->getCreatedCount());
+    $this->assertEquals(1, $con->getReusedCount());
+  }
+
+  public function testSameShardQueriesAreChecked(): void {
+    $dbh = DatabaseFactory::factory(DriverInterface::class, 'Test\Mysql');
+
+    if (!$dbh instanceof GenericPDODriver) {
+      $this->fail('Test\Mysql should hand back a GenericPDO driver');
+      return;
+    }
+
+    $dbh->disconnect();
+    $dbh->setShardType(new UInt64Box(1));
+
+    $pool = $dbh->getConnectionPool();
+    $created = $pool->getCreatedCount();
+    $reused = $pool->getReusedCount();
+
+    // Staying on one shard still goes through the pool's checked get.
+    $dbh->query('SELECT 1');
+    $dbh->query('SELECT 1');
+    $dbh->query('SELECT 1');
+
+    $this->assertEquals($created + 1, $pool->getCreatedCount());
+    $this->assertEquals($reused + 2, $pool->getReusedCount());
+  }
+
+  public function testStreamingResultLeavesShardUsable(): void {
+    $dbh = DatabaseFactory::factory(DriverInterface::class, 'Test\Mysql');
+
+    if (!$dbh instanceof GenericPDODriver) {
+      $this->fail('Test\Mysql should hand back a GenericPDO driver');
+      return;
+    }
+
+    $dbh->setShardType(new UInt64Box(1));
+    $this->assertFalse($dbh->getIsUnbufferedStreaming());
+
+    // A tiny cap puts the result straight into streaming.
+    $maxBufferedBytes = $dbh->getMaxBufferedBytes();
+    $dbh->setMaxBufferedBytes(1);
+
+    try {
+      $open = $dbh->query('SELECT 1 AS a UNION SELECT 2 UNION SELECT 3');
+      $this->assertTrue($open->next());
+
+      // libmysql still buffered the result, the connection takes another
+      // query while the first one is open.
+      $other = $dbh->query('SELECT 4 AS a');
+      $this->assertTrue($other->wasSuccessful());
+
+      $this->assertTrue($open->next());
+    } finally {
+      $dbh->setMaxBufferedBytes($maxBufferedBytes);
+    }
+  }
+
+  public function testSetMaxConnections_Invalid(): void {
+    $con = new ConnectionContainer();
+    $this->expectException(Exception::class);
+    $con->setMaxConnections(0);
+  }
+
   public function testInvalidShardId(): void {
     $con = new ConnectionContainer();
     $this->expectException(InvalidShardException::class);
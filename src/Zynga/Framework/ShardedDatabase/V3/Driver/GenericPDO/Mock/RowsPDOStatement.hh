@@ -0,0 +1,72 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\Mock;
+
+use \PDO;
+use \PDOStatement;
+
+/**
+ * Forward only statement over a fixed set of rows, counts how many times the
+ * query was (re)executed and its cursor closed. When unbuffered rowCount()
+ * only knows about the rows fetched so far, like mysql without a client side
+ * copy of the result.
+ */
+class RowsPDOStatement extends PDOStatement {
+  public Vector<string> $columnNames = Vector {};
+  public Vector<array<mixed>> $rows = Vector {};
+  public int $executeCount = 0;
+  public int $closeCount = 0;
+  public bool $unbuffered = false;
+  private int $_offset = 0;
+
+  public function execute(mixed $params = null): bool {
+    $this->executeCount++;
+    $this->_offset = 0;
+    return true;
+  }
+
+  public function fetch(
+    int $fetch_style = 0,
+    int $cursor_orientation = PDO::FETCH_ORI_NEXT,
+    int $cursor_offset = 0,
+  ): mixed {
+    if ($this->_offset >= $this->rows->count()) {
+      return false;
+    }
+    $row = $this->rows[$this->_offset];
+    $this->_offset++;
+    return $row;
+  }
+
+  public function fetchAll(
+    int $fetch_style = 0,
+    mixed $fetch_argument = null,
+    mixed $ctor_args = null,
+  ): mixed {
+    $rows = array();
+    while (($row = $this->fetch($fetch_style)) !== false) {
+      $rows[] = $row;
+    }
+    return $rows;
+  }
+
+  public function rowCount(): int {
+    if ($this->unbuffered === true) {
+      return $this->_offset;
+    }
+    return $this->rows->count();
+  }
+
+  public function closeCursor(): bool {
+    $this->closeCount++;
+    return true;
+  }
+
+  public function columnCount(): int {
+    return $this->columnNames->count();
+  }
+
+  public function getColumnMeta(int $column): mixed {
+    return array('name' => $this->columnNames[$column]);
+  }
+}
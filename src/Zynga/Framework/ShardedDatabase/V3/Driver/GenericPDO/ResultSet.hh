@@ -12,18 +12,50 @@ use Zynga\Framework\Database\V2\Exceptions\OutOfBoundsForCursorException;
 use \PDO;
 use \PDOStatement;
 
+/**
+ * Rows are pulled off the statement once into a per column buffer, so rewind
+ * and random access never go back to the server. If the buffer would grow past
+ * the byte cap the remaining rows are streamed forward only off the statement,
+ * and a rewind in that state re-executes the query like the unbuffered mode.
+ * When the driver is set to stream unbuffered this buffer is the only copy
+ * of the rows, and getNumRows() is the rows seen so far once streaming, it
+ * grows while iterating and is exact once the stream runs out.
+ *
+ * A cap of BUFFERING_DISABLED keeps the original scrollable cursor behavior.
+ */
 class ResultSet extends Base {
+  const int DEFAULT_MAX_BUFFERED_BYTES = 16777216;
+  const int BUFFERING_DISABLED = 0;
+
   private string $_sql;
   private int $_rows;
   private int $_currentPosition;
   private ?PDOStatement $_rs;
 
+  private int $_maxBufferedBytes;
+  private bool $_isFilled;
+  private bool $_isStreaming;
+  private Vector<string> $_columnNames;
+  private Vector<Vector<mixed>> $_columns;
+  private int $_bufferedRows;
+  private int $_bufferedBytes;
+
+  // Once streaming only the current row and one read ahead are in hand,
+  // _streamPosition is the last row pulled off the statement.
+  private Map<int, array<mixed>> $_streamRows;
+  private int $_streamPosition;
+  private bool $_streamDone;
+
   /**
    * Creates a wrapper for a PDO
    * @param resource $rs
    * @return ResultSet
    */
-  public function __construct(string $sql, ?PDOStatement $rs) {
+  public function __construct(
+    string $sql,
+    ?PDOStatement $rs,
+    int $maxBufferedBytes = self::DEFAULT_MAX_BUFFERED_BYTES,
+  ) {
 
     parent::__construct();
 
@@ -31,6 +63,12 @@ class ResultSet extends Base {
     $this->_currentPosition = -1;
     $this->_sql = $sql;
     $this->_rs = $rs;
+
+    $this->_maxBufferedBytes = $maxBufferedBytes;
+    $this->_columnNames = Vector {};
+    $this->_columns = Vector {};
+    $this->_streamRows = Map {};
+    $this->resetBuffer();
   }
 
   public function wasSuccessful(): bool {
@@ -50,14 +88,36 @@ class ResultSet extends Base {
   public function freeCursor(): bool {
 
     if ($this->hasCursor() === true && $this->_rs !== null) {
+      // Hands the connection back if the stream was left part way.
+      $this->_rs->closeCursor();
       $this->_rs = null;
       $this->_rows = -1;
       $this->_currentPosition = -1;
+      $this->resetBuffer();
       return true;
     }
     return false;
   }
 
+  public function isBuffered(): bool {
+    return $this->_maxBufferedBytes != self::BUFFERING_DISABLED;
+  }
+
+  /**
+   * True once the byte cap was hit and rows past the buffer are streamed.
+   */
+  public function isStreaming(): bool {
+    return $this->_isStreaming;
+  }
+
+  public function getBufferedRowCount(): int {
+    return $this->_bufferedRows;
+  }
+
+  public function getBufferedBytes(): int {
+    return $this->_bufferedBytes;
+  }
+
   public function getNumRows(): int {
     try {
       if ($this->_rows != -1) {
@@ -68,6 +128,15 @@ class ResultSet extends Base {
           'getNumRows requires a active resultset sql='.$this->_sql,
         );
       }
+      // Unbuffered on the wire rowCount() only knows what has been read, so
+      // count what the buffer pulled in instead.
+      if ($this->isBuffered() === true && $this->_rs->columnCount() > 0) {
+        $this->fillBuffer();
+        if ($this->_isStreaming === true) {
+          return $this->_streamPosition + 1;
+        }
+        return $this->_bufferedRows;
+      }
       $this->_rows = $this->_rs->rowCount();
       return $this->_rows;
     } catch (Exception $e) {
@@ -92,8 +161,12 @@ class ResultSet extends Base {
         throw new OutOfBoundsForCursorException('OOB pos='.$pos);
       }
 
-      // tell the sth to go back to first position
-      $rs->execute();
+      // Unbuffered, or the stream has already moved past what we hold, the
+      // statement has to be run again to get back.
+      if ($this->isBuffered() !== true || $this->_isStreaming === true) {
+        $rs->execute();
+        $this->resetBuffer();
+      }
 
       // reset our position to the appropriate value.
       $pos = $pos - 1;
@@ -110,6 +183,15 @@ class ResultSet extends Base {
   public function hasMore(): bool {
     try {
 
+      // Streaming, the only way to know is to read ahead one row.
+      if ($this->isBuffered() === true && $this->_isStreaming === true) {
+        if ($this->_currentPosition + 1 < $this->_bufferedRows ||
+            $this->getStreamRow($this->_currentPosition + 1) !== null) {
+          return true;
+        }
+        return false;
+      }
+
       // load up the number of rows for this query.
       $rows = $this->getNumRows();
 
@@ -141,6 +223,10 @@ class ResultSet extends Base {
 
         $this->_currentPosition++;
 
+        if ($this->isBuffered() === true) {
+          $this->fillBuffer();
+        }
+
         return true;
       }
 
@@ -162,14 +248,22 @@ class ResultSet extends Base {
 
       $rs = $this->_rs;
 
+      $data = Map {};
+
+      if ($this->isBuffered() === true) {
+        $this->fillBuffer();
+        foreach ($this->getBufferedRow() as $offset => $value) {
+          $data->set($this->_columnNames[$offset], $value);
+        }
+        return $data;
+      }
+
       $rawData = $rs->fetch(
         PDO::FETCH_ASSOC,
         PDO::FETCH_ORI_ABS,
         $this->_currentPosition,
       );
 
-      $data = Map {};
-
       if (is_array($rawData)) {
         foreach ($rawData as $key => $value) {
           $data->set($key, $value);
@@ -196,6 +290,16 @@ class ResultSet extends Base {
         );
       }
 
+      $data = Vector {};
+
+      if ($this->isBuffered() === true) {
+        $this->fillBuffer();
+        foreach ($this->getBufferedRow() as $value) {
+          $data->add($value);
+        }
+        return $data;
+      }
+
       $rawData =
         $this->_rs->fetch(
           PDO::FETCH_NUM,
@@ -203,8 +307,6 @@ class ResultSet extends Base {
           $this->_currentPosition,
         );
 
-      $data = Vector {};
-
       foreach ($rawData as $value) {
         $data->add($value);
       }
@@ -217,6 +319,117 @@ class ResultSet extends Base {
 
   }
 
+  /**
+   * Served straight from the column buffer when nothing has been read yet,
+   * otherwise (or once streaming) falls back to the row at a time path.
+   */
+  public function fetchAllColumns(): Map<string, Vector<mixed>> {
+
+    if ($this->_rs === null) {
+      throw new NoActiveCursorException(
+        'fetchAllColumns requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    if ($this->_currentPosition != -1) {
+      return parent::fetchAllColumns();
+    }
+
+    $rs = $this->_rs;
+
+    // Unbuffered, a single native fetchAll.
+    if ($this->isBuffered() !== true) {
+
+      $columnNames = Vector {};
+      for ($offset = 0; $offset < $rs->columnCount(); $offset++) {
+        $meta = $rs->getColumnMeta($offset);
+        $columnNames->add(strval($meta['name']));
+      }
+
+      $rows = null;
+      if ($columnNames->count() > 0) {
+        $rows = $rs->fetchAll(PDO::FETCH_NUM);
+      }
+
+      $this->_currentPosition = $this->getNumRows() - 1;
+
+      return
+        $this->pivotToColumns($columnNames, is_array($rows) ? $rows : array());
+
+    }
+
+    $this->fillBuffer();
+
+    if ($this->_isStreaming === true) {
+      return parent::fetchAllColumns();
+    }
+
+    $columns = Map {};
+    foreach ($this->_columnNames as $offset => $name) {
+      $columns->set($name, $this->_columns[$offset]->toVector());
+    }
+
+    $this->_currentPosition = $this->_bufferedRows - 1;
+
+    return $columns;
+
+  }
+
+  public function fetchAllVectors(): Vector<Vector<mixed>> {
+
+    if ($this->_rs === null) {
+      throw new NoActiveCursorException(
+        'fetchAllVectors requires a active resultset sql='.$this->_sql,
+      );
+    }
+
+    if ($this->_currentPosition != -1) {
+      return parent::fetchAllVectors();
+    }
+
+    $rs = $this->_rs;
+
+    $data = Vector {};
+
+    if ($this->isBuffered() !== true) {
+
+      $rows = null;
+      if ($rs->columnCount() > 0) {
+        $rows = $rs->fetchAll(PDO::FETCH_NUM);
+      }
+
+      if (is_array($rows)) {
+        foreach ($rows as $row) {
+          $data->add(new Vector($row));
+        }
+      }
+
+      $this->_currentPosition = $this->getNumRows() - 1;
+
+      return $data;
+
+    }
+
+    $this->fillBuffer();
+
+    if ($this->_isStreaming === true) {
+      return parent::fetchAllVectors();
+    }
+
+    for ($position = 0; $position < $this->_bufferedRows; $position++) {
+      $row = Vector {};
+      foreach ($this->_columns as $column) {
+        $row->add($column[$position]);
+      }
+      $data->add($row);
+    }
+
+    $this->_currentPosition = $this->_bufferedRows - 1;
+
+    return $data;
+
+  }
+
   public function setSql(string $sql): bool {
     $this->_sql = $sql;
     return true;
@@ -233,4 +446,137 @@ class ResultSet extends Base {
     return false;
   }
 
+  private function resetBuffer(): void {
+    $this->_isFilled = false;
+    $this->_isStreaming = false;
+    $this->_columnNames->clear();
+    $this->_columns->clear();
+    $this->_bufferedRows = 0;
+    $this->_bufferedBytes = 0;
+    $this->_streamRows->clear();
+    $this->_streamPosition = -1;
+    $this->_streamDone = false;
+  }
+
+  /**
+   * Pulls rows off the statement into the column buffer until it runs out of
+   * rows or the next row would push it past the byte cap.
+   */
+  private function fillBuffer(): void {
+
+    if ($this->_isFilled === true) {
+      return;
+    }
+
+    $this->_isFilled = true;
+
+    $rs = $this->_rs;
+
+    if ($rs === null) {
+      return;
+    }
+
+    $columnCount = $rs->columnCount();
+
+    // DML has no rows to fetch.
+    if ($columnCount == 0) {
+      return;
+    }
+
+    for ($offset = 0; $offset < $columnCount; $offset++) {
+      $meta = $rs->getColumnMeta($offset);
+      $this->_columnNames->add(strval($meta['name']));
+      $this->_columns->add(Vector {});
+    }
+
+    while (($row = $rs->fetch(PDO::FETCH_NUM)) !== false) {
+
+      $rowBytes = 0;
+      foreach ($row as $value) {
+        $rowBytes += is_string($value) ? strlen($value) : 8;
+      }
+
+      if ($this->_maxBufferedBytes > 0 &&
+          $this->_bufferedBytes + $rowBytes > $this->_maxBufferedBytes) {
+        $this->_isStreaming = true;
+        $this->_streamPosition = $this->_bufferedRows;
+        $this->_streamRows->set($this->_streamPosition, $row);
+        return;
+      }
+
+      foreach ($row as $offset => $value) {
+        $this->_columns[$offset]->add($value);
+      }
+
+      $this->_bufferedRows++;
+      $this->_bufferedBytes += $rowBytes;
+
+    }
+
+    // Everything is in the buffer, free the connection for the next query.
+    $rs->closeCursor();
+
+  }
+
+  /**
+   * Reads the stream forward to $position, rows behind the cursor are let go.
+   * Null once the statement has run out of rows.
+   */
+  private function getStreamRow(int $position): ?array<mixed> {
+
+    $rs = $this->_rs;
+
+    while ($rs !== null &&
+           $this->_streamDone !== true &&
+           $this->_streamPosition < $position) {
+
+      $row = $rs->fetch(PDO::FETCH_NUM);
+
+      if (!is_array($row)) {
+        $this->_streamDone = true;
+        $rs->closeCursor();
+        break;
+      }
+
+      $this->_streamPosition++;
+      $this->_streamRows->set($this->_streamPosition, $row);
+
+    }
+
+    foreach ($this->_streamRows->keys() as $held) {
+      if ($held < $this->_currentPosition) {
+        $this->_streamRows->remove($held);
+      }
+    }
+
+    return $this->_streamRows->get($position);
+
+  }
+
+  private function getBufferedRow(): Vector<mixed> {
+
+    $position = $this->_currentPosition;
+
+    $row = Vector {};
+
+    if ($position >= 0 && $position < $this->_bufferedRows) {
+      foreach ($this->_columns as $column) {
+        $row->add($column[$position]);
+      }
+      return $row;
+    }
+
+    if ($this->_isStreaming === true) {
+      $streamRow = $this->getStreamRow($position);
+      if ($streamRow !== null) {
+        foreach ($streamRow as $value) {
+          $row->add($value);
+        }
+      }
+    }
+
+    return $row;
+
+  }
+
 }
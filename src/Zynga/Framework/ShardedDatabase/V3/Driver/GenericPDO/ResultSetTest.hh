@@ -0,0 +1,175 @@
+<?hh //strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO;
+
+use
+  Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\Mock\RowsPDOStatement
+;
+use Zynga\Framework\ShardedDatabase\V3\Driver\GenericPDO\ResultSet;
+use Zynga\Framework\Testing\TestCase\V2\Base as TestCase;
+
+class ResultSetTest extends TestCase {
+
+  private function createStatement(int $rowCount): RowsPDOStatement {
+    $sth = new RowsPDOStatement();
+    $sth->columnNames = Vector {'id', 'name'};
+    for ($i = 0; $i < $rowCount; $i++) {
+      $sth->rows->add(array($i, 'name-'.$i));
+    }
+    return $sth;
+  }
+
+  public function testBuffered_RewindStaysInMemory(): void {
+
+    $sth = $this->createStatement(3);
+    $resultSet = new ResultSet('SELECT id, name FROM test', $sth);
+
+    $this->assertTrue($resultSet->isBuffered());
+
+    $this->assertTrue($resultSet->next());
+    $this->assertEquals(
+      Map {'id' => 0, 'name' => 'name-0'},
+      $resultSet->fetchMap(),
+    );
+
+    $this->assertTrue($resultSet->next());
+    $this->assertTrue($resultSet->next());
+    $this->assertEquals(Vector {2, 'name-2'}, $resultSet->fetchVector());
+    $this->assertFalse($resultSet->next());
+
+    $this->assertTrue($resultSet->rewind(1));
+    $this->assertTrue($resultSet->next());
+    $this->assertEquals(Vector {1, 'name-1'}, $resultSet->fetchVector());
+
+    $this->assertEquals(0, $sth->executeCount);
+    $this->assertEquals(3, $resultSet->getBufferedRowCount());
+    $this->assertFalse($resultSet->isStreaming());
+
+  }
+
+  public function testBuffered_CapFallsBackToStreaming(): void {
+
+    $sth = $this->createStatement(4);
+
+    // Each row is 8 bytes for the int plus 6 for the name.
+    $resultSet = new ResultSet('SELECT id, name FROM test', $sth, 28);
+
+    $ids = Vector {};
+    while ($resultSet->next() === true) {
+      $ids->add($resultSet->fetchMap()['id']);
+    }
+
+    $this->assertEquals(Vector {0, 1, 2, 3}, $ids);
+    $this->assertTrue($resultSet->isStreaming());
+    $this->assertEquals(2, $resultSet->getBufferedRowCount());
+    $this->assertEquals(28, $resultSet->getBufferedBytes());
+
+    // Going back once streamed costs a re-execute.
+    $this->assertTrue($resultSet->rewind(0));
+    $this->assertTrue($resultSet->next());
+    $this->assertEquals(Vector {0, 'name-0'}, $resultSet->fetchVector());
+    $this->assertEquals(1, $sth->executeCount);
+
+  }
+
+  public function testBuffered_UnbufferedStatementCountsRows(): void {
+
+    $sth = $this->createStatement(3);
+    $sth->unbuffered = true;
+
+    $resultSet = new ResultSet('SELECT id, name FROM test', $sth);
+
+    // rowCount() is 0 before the first fetch, the buffer knows better.
+    $this->assertEquals(3, $resultSet->getNumRows());
+    $this->assertEquals(1, $sth->closeCount);
+
+    $empty = $this->createStatement(0);
+    $empty->unbuffered = true;
+    $this->assertEquals(
+      0,
+      (new ResultSet('SELECT id, name FROM test', $empty))->getNumRows(),
+    );
+
+  }
+
+  public function testBuffered_StreamingCountGrows(): void {
+
+    $sth = $this->createStatement(4);
+    $sth->unbuffered = true;
+
+    $resultSet = new ResultSet('SELECT id, name FROM test', $sth, 28);
+
+    // Two rows fit in the buffer, the third is already in hand.
+    $this->assertEquals(3, $resultSet->getNumRows());
+    $this->assertEquals(0, $sth->closeCount);
+
+    while ($resultSet->next() === true) {}
+
+    $this->assertEquals(4, $resultSet->getNumRows());
+    $this->assertEquals(1, $sth->closeCount);
+
+  }
+
+  public function testFetchAllColumns_Buffered(): void {
+
+    $resultSet =
+      new ResultSet('SELECT id, name FROM test', $this->createStatement(3));
+
+    $this->assertEquals(
+      Map {
+        'id' => Vector {0, 1, 2},
+        'name' => Vector {'name-0', 'name-1', 'name-2'},
+      },
+      $resultSet->fetchAllColumns(),
+    );
+    $this->assertFalse($resultSet->next());
+
+  }
+
+  public function testFetchAllVectors_AfterNext(): void {
+
+    $resultSet =
+      new ResultSet('SELECT id, name FROM test', $this->createStatement(3));
+
+    $this->assertTrue($resultSet->next());
+
+    // Only the rows past the cursor come back.
+    $this->assertEquals(
+      Vector {Vector {1, 'name-1'}, Vector {2, 'name-2'}},
+      $resultSet->fetchAllVectors(),
+    );
+
+  }
+
+  public function testFetchAllColumns_Unbuffered(): void {
+
+    $resultSet = new ResultSet(
+      'SELECT id, name FROM test',
+      $this->createStatement(2),
+      ResultSet::BUFFERING_DISABLED,
+    );
+
+    $this->assertEquals(
+      Map {'id' => Vector {0, 1}, 'name' => Vector {'name-0', 'name-1'}},
+      $resultSet->fetchAllColumns(),
+    );
+    $this->assertFalse($resultSet->hasMore());
+
+  }
+
+  public function testUnbuffered_RewindReExecutes(): void {
+
+    $sth = $this->createStatement(1);
+    $resultSet = new ResultSet(
+      'SELECT id, name FROM test',
+      $sth,
+      ResultSet::BUFFERING_DISABLED,
+    );
+
+    $this->assertFalse($resultSet->isBuffered());
+    $this->assertTrue($resultSet->rewind(0));
+    $this->assertEquals(1, $sth->executeCount);
+
+  }
+
+}
@@ -9,6 +9,7 @@ use Zynga\Framework\Type\V1\Interfaces\TypeInterface;
 
 class Transaction<TType as TypeInterface> implements TransactionInterface {
   private DriverInterface<TType> $_dbh;
+  private bool $_isOpen = false;
 
   public function __construct(DriverInterface<TType> $driver) {
     $this->_dbh = $driver;
@@ -17,6 +18,7 @@ class Transaction<TType as TypeInterface> implements TransactionInterface {
   public function begin(): bool {
     try {
       $this->_dbh->query('START TRANSACTION');
+      $this->_isOpen = true;
       return true;
     } catch (Exception $e) {
       throw $e;
@@ -25,6 +27,7 @@ class Transaction<TType as TypeInterface> implements TransactionInterface {
 
   public function commit(): bool {
     try {
+      $this->_isOpen = false;
       $this->_dbh->query('COMMIT');
       return true;
     } catch (Exception $e) {
@@ -34,6 +37,7 @@ class Transaction<TType as TypeInterface> implements TransactionInterface {
 
   public function rollback(): bool {
     try {
+      $this->_isOpen = false;
       $this->_dbh->query('ROLLBACK');
       return true;
     } catch (Exception $e) {
@@ -41,4 +45,11 @@ class Transaction<TType as TypeInterface> implements TransactionInterface {
     }
   }
 
+  /**
+   * True between a begin() and its commit() / rollback().
+   */
+  public function isOpen(): bool {
+    return $this->_isOpen;
+  }
+
 }
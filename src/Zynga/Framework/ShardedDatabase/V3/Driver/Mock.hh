@@ -128,6 +128,14 @@ class Mock<TType as TypeInterface> extends Base<TType> {
 
   }
 
+  public function queryShard(
+    int $shardIndex,
+    string $sql,
+  ): ResultSetInterface {
+    // Mock result sets are handed out in order whatever the shard.
+    return $this->query($sql);
+  }
+
   public function resetResultsSets(): bool {
     $this->_resultSets->clear();
     $this->_isConnected = false;
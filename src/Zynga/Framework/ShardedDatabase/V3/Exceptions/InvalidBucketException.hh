@@ -0,0 +1,7 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Exceptions;
+
+use Zynga\Framework\Exception\V1\Exception;
+
+class InvalidBucketException extends Exception {}
@@ -64,6 +64,14 @@ interface DriverConfigInterface<TType as TypeInterface>
    */
   public function getShardId(TType $shardType): int;
 
+  /**
+   * While a virtual bucket is being moved, the shard id reads should fall back
+   * to when the row is not on getShardId() yet.
+   * @param TType $shardType
+   * @return ?int
+   */
+  public function getFallbackShardId(TType $shardType): ?int;
+
   /**
    * For sharded databases return the string hostname for your shard
    * @param int $sn
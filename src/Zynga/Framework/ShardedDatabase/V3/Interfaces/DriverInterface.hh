@@ -38,4 +38,34 @@ interface DriverInterface<TType as TypeInterface>
     string $connectionString,
   ): bool;
 
+  /**
+   * Runs the sql against the shard at $shardIndex, whatever the current shard
+   * type points at.
+   *
+   * @param int $shardIndex
+   * @param string $sql
+   * @return ResultSetInterface
+   */
+  public function queryShard(int $shardIndex, string $sql): ResultSetInterface;
+
+  /**
+   * Runs the same sql against every shard, or the given subset, keyed by
+   * shard index.
+   *
+   * @param string $sql
+   * @param ?Vector<int> $shardIndexes
+   * @return Awaitable<Map<int, ResultSetInterface>>
+   */
+  public function genQueryAllShards(
+    string $sql,
+    ?Vector<int> $shardIndexes = null,
+  ): Awaitable<Map<int, ResultSetInterface>>;
+
+  /**
+   * Latency in milliseconds per shard index for the last genQueryAllShards().
+   *
+   * @return Map<int, float>
+   */
+  public function getShardLatencies(): Map<int, float>;
+
 }
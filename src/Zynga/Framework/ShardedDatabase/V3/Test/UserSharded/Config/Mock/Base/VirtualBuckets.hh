@@ -0,0 +1,26 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Test\UserSharded\Config\Mock\Base;
+
+use
+  Zynga\Framework\ShardedDatabase\V3\Config\Mock\Base as ConfigBase
+;
+use Zynga\Framework\ShardedDatabase\V3\ConnectionDetails;
+
+class VirtualBuckets extends ConfigBase {
+  const int BUCKET_COUNT = 64;
+
+  public function shardsInit(): bool {
+    $this->addServer(
+      new ConnectionDetails('someusername', 'somepassword', 'localhost', 123),
+    );
+    $this->addServer(
+      new ConnectionDetails('someusername', 'somepassword', 'localhost', 124),
+    );
+    return true;
+  }
+
+  public function getVirtualBucketCount(): int {
+    return self::BUCKET_COUNT;
+  }
+}
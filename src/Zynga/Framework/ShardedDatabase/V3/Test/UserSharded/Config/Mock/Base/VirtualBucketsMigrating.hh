@@ -0,0 +1,20 @@
+<?hh // strict
+
+namespace Zynga\Framework\ShardedDatabase\V3\Test\UserSharded\Config\Mock\Base;
+
+use Zynga\Framework\ShardedDatabase\V3\BucketMap;
+
+class VirtualBucketsMigrating extends VirtualBuckets {
+  const int MOVING_BUCKET = 3;
+
+  public function bucketsInit(BucketMap $bucketMap): bool {
+    parent::bucketsInit($bucketMap);
+    // Bucket 3 round robins onto server 1, it is on its way to server 0.
+    $bucketMap->assign(self::MOVING_BUCKET, 0);
+    return true;
+  }
+
+  public function getBucketMoves(): Map<int, int> {
+    return Map {self::MOVING_BUCKET => 1};
+  }
+}
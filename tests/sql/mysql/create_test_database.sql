@@ -2,6 +2,7 @@ CREATE DATABASE IF NOT EXISTS `phpunit`;
 
 DROP TABLE IF EXISTS phpunit.phpunit;
 DROP TABLE IF EXISTS phpunit.item_type;
+DROP TABLE IF EXISTS phpunit.versioned_item_type;
 
 CREATE TABLE IF NOT EXISTS `phpunit`.`phpunit` (
   `unit_test_stamp` int(11) NOT NULL,
@@ -20,6 +21,15 @@ INSERT INTO phpunit.item_type (id, name) VALUES ( 12387453, 'this-is-a-test-valu
 INSERT INTO phpunit.item_type (id, name) VALUES ( 12387454, 'this-is-a-test-valueset-4');
 INSERT INTO phpunit.item_type (id, name) VALUES ( 12387455, 'this-is-a-test-valueset-5');
 
+CREATE TABLE IF NOT EXISTS phpunit.versioned_item_type (
+  id int(11) NOT NULL AUTO_INCREMENT,
+  name VARCHAR(255) NOT NULL,
+  version int(11) NOT NULL DEFAULT 0,
+  PRIMARY KEY(id)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8;
+
+INSERT INTO phpunit.versioned_item_type (id, name, version) VALUES ( 12387461, 'this-is-a-versioned-valueset-1', 0);
+
 CREATE TABLE IF NOT EXISTS phpunit.user_inventory (
   id int(11) NOT NULL AUTO_INCREMENT,
   user_id int(11) NOT NULL DEFAULT 0,